@@ -82,6 +82,7 @@ int main(int argc, char **argv) {
     }
 
     EngineApp::run();
+    EngineApp::terminate();
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,78 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Util/Util.hpp"
+#include "Component/SpatialComponents/SpatialComponent.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
+#include "Component/SpatialComponents/AnimationComponents.hpp"
+
+
+
+namespace {
+
+// Updates every component registered as BaseT once per frame, either through
+// its list with a virtual call each, or as the scene's systems do, and
+// returns the time per component
+template <typename BaseT, typename... CompTs>
+Samples timeUpdates(const BenchOptions & options, bool batched) {
+    const Vector<BaseT *> & comps(Scene::getComponents<BaseT>());
+    Samples samples;
+    for (int frame(0); frame < options.frames; ++frame) {
+        Util::Stopwatch watch;
+        if (batched) {
+            Scene::updateComponents<BaseT, CompTs...>(options.dt);
+        }
+        else {
+            for (BaseT * comp : comps) {
+                comp->update(options.dt);
+            }
+        }
+        samples.add(watch.total() / double(comps.size()));
+    }
+    return samples;
+}
+
+}
+
+
+
+int batchBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    // concrete types are interleaved, as they would be when spawned over the
+    // course of a game, so virtual calls don't all go to the same place
+    int nObjects(options.count > 0 ? options.count : 10000);
+    for (int i(0); i < nObjects; ++i) {
+        GameObject & obj(Scene::createGameObject());
+        SpatialComponent & spatial(Scene::addComponent<SpatialComponent>(obj, glm::vec3(Util::random(-50.0f, 50.0f), Util::random(0.0f, 20.0f), Util::random(-150.0f, 0.0f))));
+        Scene::addComponent<NewtonianComponent>(obj, false);
+        if (i % 2) {
+            Scene::addComponentAs<GravityComponent, AcceleratorComponent>(obj);
+            Scene::addComponentAs<SpinAnimationComponent, AnimationComponent>(obj, spatial, glm::vec3(0.0f, 1.0f, 0.0f), 1.0f);
+        }
+        else {
+            Scene::addComponent<AcceleratorComponent>(obj, glm::vec3(0.0f, 1.0f, 0.0f));
+            Scene::addComponentAs<ScaleToAnimationComponent, AnimationComponent>(obj, spatial, glm::vec3(2.0f), 1.0f);
+        }
+    }
+    // initializes them
+    Bench::step(options.dt);
+
+    std::cout << nObjects << " objects, each with a spatial, newtonian, accelerator, and animation" << std::endl;
+
+    Bench::printHeader("Component updates, per component", true);
+    Bench::printRow("Accelerator virtual", timeUpdates<AcceleratorComponent>(options, false), true);
+    Bench::printRow("Accelerator batched", timeUpdates<AcceleratorComponent, GravityComponent, AcceleratorComponent>(options, true), true);
+    Bench::printRow("Newtonian virtual", timeUpdates<NewtonianComponent>(options, false), true);
+    Bench::printRow("Newtonian batched", timeUpdates<NewtonianComponent>(options, true), true);
+    Bench::printRow("Animation virtual", timeUpdates<AnimationComponent>(options, false), true);
+    Bench::printRow("Animation batched", timeUpdates<AnimationComponent, SpinAnimationComponent, ScaleToAnimationComponent>(options, true), true);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "glm/gtc/constants.hpp"
+
+#include "EngineApp/EngineApp.hpp"
+#include "IO/Window.hpp"
+#include "Scene/Scene.hpp"
+#include "System/GameInterface.hpp"
+#include "Util/JobSystem.hpp"
+#include "Util/Util.hpp"
+#include "Component/EnemyComponents/EnemyComponent.hpp"
+#include "Component/WeaponComponents/ProjectileComponents.hpp"
+
+
+
+double Samples::mean() const {
+    if (m_values.empty()) {
+        return 0.0;
+    }
+    double sum(0.0);
+    for (double value : m_values) {
+        sum += value;
+    }
+    return sum / double(m_values.size());
+}
+
+double Samples::percentile(double p) const {
+    if (m_values.empty()) {
+        return 0.0;
+    }
+    Vector<double> sorted(m_values);
+    std::sort(sorted.begin(), sorted.end());
+    int rank(int(std::ceil(p / 100.0 * double(sorted.size()))) - 1);
+    return sorted[glm::clamp(rank, 0, int(sorted.size()) - 1)];
+}
+
+
+
+bool Bench::setUp(const BenchOptions & options) {
+    if (EngineApp::init()) {
+        return false;
+    }
+    if (options.threads > 0) {
+        JobSystem::shutDown();
+        JobSystem::init(options.threads - 1);
+    }
+    std::srand(options.seed);
+    if (!options.memoryCSV.empty() && !MemoryStats::openCSV(options.memoryCSV.c_str())) {
+        std::cerr << "Failed to open " << options.memoryCSV << std::endl;
+    }
+
+    // the game starts on the first frame, which kills off any enemies
+    step(options.dt);
+
+    return true;
+}
+
+void Bench::tearDown() {
+    MemoryStats::closeCSV();
+    EngineApp::terminate();
+}
+
+void Bench::populate(const BenchOptions & options) {
+    for (int n(int(Scene::getComponents<EnemyComponent>().size())); n < options.enemies; ++n) {
+        GameInterface::spawnEnemy(GameInterface::randomSpawnPoint());
+    }
+    for (int n(int(Scene::getComponents<ProjectileComponent>().size())); n < options.projectiles; ++n) {
+        float angle(Util::random() * 2.0f * glm::pi<float>());
+        glm::vec3 position(GameInterface::randomSpawnPoint() + glm::vec3(0.0f, 2.0f, 0.0f));
+        GameInterface::fireProjectile(position, glm::vec3(std::cos(angle), 0.0f, std::sin(angle)));
+    }
+    GameInterface::restorePlayer();
+}
+
+void Bench::step(float dt) {
+    Window::update(dt);
+    Scene::update(dt);
+}
+
+void Bench::printHeader(const String & title, bool nanoseconds) {
+    const char * unit(nanoseconds ? "(ns)" : "(ms)");
+    std::cout << std::endl << title << std::endl;
+    std::cout << std::left << std::setw(32) << "" << std::right
+        << std::setw(12) << (String("mean ") + unit)
+        << std::setw(12) << (String("p50 ") + unit)
+        << std::setw(12) << (String("p99 ") + unit) << std::endl;
+}
+
+void Bench::printRow(const String & name, const Samples & samples, bool nanoseconds) {
+    double scale(nanoseconds ? 1.0e9 : 1.0e3);
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(3)
+        << std::setw(12) << samples.mean() * scale
+        << std::setw(12) << samples.percentile(50.0) * scale
+        << std::setw(12) << samples.percentile(99.0) * scale << std::endl;
+}
+
+void Bench::printCountHeader(const String & title) {
+    std::cout << std::endl << title << std::endl;
+    std::cout << std::left << std::setw(32) << "" << std::right
+        << std::setw(12) << "mean"
+        << std::setw(12) << "p50"
+        << std::setw(12) << "p99" << std::endl;
+}
+
+void Bench::printCountRow(const String & name, const Samples & samples) {
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+        << std::setw(12) << samples.mean()
+        << std::setw(12) << samples.percentile(50.0)
+        << std::setw(12) << samples.percentile(99.0) << std::endl;
+}
@@ -0,0 +1,126 @@
+/* Benchmark
+ * Shared setup and reporting for the headless benchmark scenarios */
+#pragma once
+#ifndef _BENCH_HPP_
+#define _BENCH_HPP_
+
+
+
+#include "Util/Memory.hpp"
+
+
+
+struct BenchOptions {
+    int frames = 600;            /* Number of fixed-dt frames to run */
+    float dt = 1.0f / 60.0f;     /* Time step of each frame */
+    int enemies = 100;           /* Enemies kept alive throughout */
+    int projectiles = 0;         /* Projectiles kept in the air throughout */
+    int count = 0;               /* Scenario specific object count, 0 for its default */
+    int threads = -1;            /* Threads running jobs, -1 for one per core */
+    unsigned int seed = 1;       /* Random seed, so runs are comparable */
+    String trace;                /* Chrome trace of the run's last frames, empty for none */
+    String memoryCSV;            /* Allocations per memory category each frame, empty for none */
+};
+
+
+
+// A series of timings, in seconds
+class Samples {
+
+    public:
+
+    void add(double value) { m_values.push_back(value); }
+
+    int count() const { return int(m_values.size()); }
+
+    double mean() const;
+
+    // Value below which p percent of the samples fall
+    double percentile(double p) const;
+
+    private:
+
+    Vector<double> m_values;
+
+};
+
+
+
+namespace Bench {
+
+    // Starts the engine and game without a window and runs the first frame,
+    // which starts the game. Returns false if the engine couldn't start
+    bool setUp(const BenchOptions & options);
+
+    void tearDown();
+
+    // Spawns enemies and fires projectiles until there are as many as asked
+    // for, and keeps the player alive so they stay that way
+    void populate(const BenchOptions & options);
+
+    // Runs one frame as EngineApp would
+    void step(float dt);
+
+    // Prints a table of mean, p50, and p99 per row, with values in ms or ns
+    void printHeader(const String & title, bool nanoseconds = false);
+    void printRow(const String & name, const Samples & samples, bool nanoseconds = false);
+
+    // For samples that are counts rather than times
+    void printCountHeader(const String & title);
+    void printCountRow(const String & name, const Samples & samples);
+
+}
+
+
+
+// Scenarios, each returning the program's exit code
+
+// Whole frames of the game, broken down by scheduler task
+int frameBench(const BenchOptions & options);
+
+// Iterating and updating every SpatialComponent
+int spatialBench(const BenchOptions & options);
+
+// getComponentByType calls made by collision receivers
+int componentLookupBench(const BenchOptions & options);
+
+// CollisionMessages relayed per second with all the enemies piled up in one spot
+int collisionMessageBench(const BenchOptions & options);
+
+// Particle and newtonian updates run serially and with the job system, on
+// 1 to N threads, and newtonians run through the batched integrator
+int jobBench(const BenchOptions & options);
+
+// Component updates through virtual calls, against batches of each concrete
+// type updated with no virtual dispatch
+int batchBench(const BenchOptions & options);
+
+// Unloading and reloading GameLevel_02 and GameLevel_03, timing each load and
+// how much the process grows
+int levelBench(const BenchOptions & options);
+
+// Frames of objects that are all moving and colliding, timing the spatial
+// rollover at the start of the frame and the spatial and collision systems
+int moverBench(const BenchOptions & options);
+
+// A wave of enemies crowded around the player, most blocked in place, timing
+// the collision system with resting bodies kept awake and put to sleep
+int restBench(const BenchOptions & options);
+
+// 100 up to 5000 moving capsules in GameLevel_03, timing the collision system
+// with the octree and with sweep and prune as the broadphase, and checking the
+// two find the same overlapping pairs. Built with TRACK_MEMORY, also counts
+// what the octree allocates each frame
+int broadphaseBench(const BenchOptions & options);
+
+// Rays and regions against GameLevel_03's static bounders, in the octree and
+// in the BVH the collision system now keeps them in
+int staticsBench(const BenchOptions & options);
+
+// How many elements each Octree::filter call hands back to be tested in
+// GameLevel_03, with the octree tight and loose
+int looseBench(const BenchOptions & options);
+
+
+
+#endif
@@ -0,0 +1,144 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Scene/Scheduler.hpp"
+#include "System/CollisionSystem.hpp"
+#include "Util/Broadphase.hpp"
+#include "Util/Util.hpp"
+#include "Component/SpatialComponents/SpatialComponent.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
+#include "Component/CollisionComponents/BounderComponent.hpp"
+
+
+
+namespace {
+
+const int k_counts[] = { 100, 500, 1000, 2500, 5000 };
+
+bool overlaps(const AABox & b1, const AABox & b2) {
+    return
+        b1.min.x <= b2.max.x && b2.min.x <= b1.max.x &&
+        b1.min.y <= b2.max.y && b2.min.y <= b1.max.y &&
+        b1.min.z <= b2.max.z && b2.min.z <= b1.max.z;
+}
+
+// Every pair of bounders whose boxes overlap, according to the current
+// broadphase, with the lower address first
+Vector<std::pair<const BounderComponent *, const BounderComponent *>> detPairs() {
+    Vector<std::pair<const BounderComponent *, const BounderComponent *>> pairs;
+    Vector<const BounderComponent *> results;
+    for (const BounderComponent * bounder : Scene::getComponents<BounderComponent>()) {
+        results.clear();
+        CollisionSystem::broadphase()->filter(bounder, results);
+        for (const BounderComponent * other : results) {
+            // the octree gives anything nearby, so only keep real overlaps
+            if (other < bounder && overlaps(bounder->enclosingAABox(), other->enclosingAABox())) {
+                pairs.emplace_back(other, bounder);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+}
+
+void run(const BenchOptions & options, int collisionTask, Samples & r_samples, Samples * r_octreeAllocations = nullptr) {
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    for (int frame(0); frame < options.frames; ++frame) {
+        Bench::step(options.dt);
+        r_samples.add(double(tasks[collisionTask].updateDT));
+        if (r_octreeAllocations) {
+            r_octreeAllocations->add(double(MemoryStats::total(MemoryCategory::Octree).frameAllocations));
+        }
+    }
+}
+
+void useOctree() {
+    // same as the game sets up for GameLevel_03
+    CollisionSystem::setOctree(glm::vec3(-70.0f, -10.0f, -210.0f), glm::vec3(70.0f, 50.0f, 40.0f), 1.0f);
+}
+
+}
+
+
+
+int broadphaseBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    int collisionTask(0);
+    while (collisionTask < int(tasks.size()) && tasks[collisionTask].name != "Collision") {
+        ++collisionTask;
+    }
+    assert(collisionTask < int(tasks.size()));
+
+    int maxCapsules(options.count > 0 ? options.count : 5000);
+    Vector<int> counts;
+    for (int count : k_counts) {
+        if (count < maxCapsules) counts.push_back(count);
+    }
+    counts.push_back(maxCapsules);
+
+    Vector<Samples> octreeSamples(counts.size()), sapSamples(counts.size()), octreeAllocationSamples(counts.size());
+    Vector<size_t> nPairs(counts.size());
+    bool allMatch(true);
+    int nCapsules(0);
+    for (size_t c(0); c < counts.size(); ++c) {
+        // no gravity, so they keep moving, bouncing off the level and each other
+        for (; nCapsules < counts[c]; ++nCapsules) {
+            GameObject & obj(Scene::createGameObject());
+            Scene::addComponent<SpatialComponent>(obj, glm::vec3(Util::random(-50.0f, 50.0f), Util::random(1.0f, 20.0f), Util::random(-150.0f, 0.0f)));
+            NewtonianComponent & newtonian(Scene::addComponent<NewtonianComponent>(obj, true));
+            newtonian.setVelocity(glm::vec3(Util::random(-5.0f, 5.0f), Util::random(-5.0f, 5.0f), Util::random(-5.0f, 5.0f)));
+            Scene::addComponentAs<CapsuleBounderComponent, BounderComponent>(obj, 1, Capsule(glm::vec3(), 0.5f, 1.0f));
+        }
+
+        useOctree();
+        Bench::step(options.dt);
+        run(options, collisionTask, octreeSamples[c], &octreeAllocationSamples[c]);
+
+        // sweep and prune is built fresh here, then kept up frame by frame
+        CollisionSystem::setSweepAndPrune();
+        run(options, collisionTask, sapSamples[c]);
+
+        // compares the pairs it ended up with to a new octree's
+        Vector<std::pair<const BounderComponent *, const BounderComponent *>> sapPairs(detPairs());
+        useOctree();
+        Vector<std::pair<const BounderComponent *, const BounderComponent *>> octreePairs(detPairs());
+        nPairs[c] = sapPairs.size();
+        if (sapPairs != octreePairs) {
+            std::cerr << counts[c] << " capsules: sweep and prune found " << sapPairs.size() << " pairs, the octree " << octreePairs.size() << std::endl;
+            allMatch = false;
+        }
+    }
+
+    Bench::printHeader("Collision system, per frame");
+    for (size_t c(0); c < counts.size(); ++c) {
+        Bench::printRow(String(std::to_string(counts[c]).c_str()) + " capsules, octree", octreeSamples[c]);
+        Bench::printRow(String(std::to_string(counts[c]).c_str()) + " capsules, sweep and prune", sapSamples[c]);
+    }
+
+#ifdef TRACK_MEMORY
+    // should settle at none once the octree's pools have grown big enough
+    Bench::printCountHeader("Octree allocations per frame");
+    for (size_t c(0); c < counts.size(); ++c) {
+        Bench::printCountRow(String(std::to_string(counts[c]).c_str()) + " capsules", octreeAllocationSamples[c]);
+    }
+#endif
+
+    std::cout << std::endl;
+    for (size_t c(0); c < counts.size(); ++c) {
+        std::cout << counts[c] << " capsules: " << nPairs[c] << " overlapping pairs" << std::endl;
+    }
+    std::cout << (allMatch ? "Pair sets match" : "Pair sets DIFFER") << std::endl;
+
+    Bench::tearDown();
+    return allMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,68 @@
+#include "Bench.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Scene/Scheduler.hpp"
+#include "System/GameInterface.hpp"
+#include "Util/Util.hpp"
+
+
+
+int collisionMessageBench(const BenchOptions & options) {
+    BenchOptions pileUp(options);
+    pileUp.enemies = options.count > 0 ? options.count : 500;
+    pileUp.projectiles = 0;
+    if (!Bench::setUp(pileUp)) {
+        return EXIT_FAILURE;
+    }
+
+    // everyone starts in the same spot, and they all head for the player
+    glm::vec3 spot(GameInterface::randomSpawnPoint());
+    for (int i(0); i < pileUp.enemies; ++i) {
+        GameInterface::spawnEnemy(spot + glm::vec3(Util::random(-0.5f, 0.5f), 0.0f, Util::random(-0.5f, 0.5f)));
+    }
+
+    int nMessages(0);
+    auto collisionCallback([&](const CollisionMessage & msg) {
+        ++nMessages;
+    });
+    ReceiverHandle receiver(Scene::addReceiver<CollisionMessage>(nullptr, collisionCallback));
+
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    int collisionTask(0);
+    while (collisionTask < int(tasks.size()) && tasks[collisionTask].name != "Collision") {
+        ++collisionTask;
+    }
+    assert(collisionTask < int(tasks.size()));
+
+    Samples countSamples, perMessageSamples;
+    double totalMessages(0.0), totalRelayTime(0.0);
+    for (int frame(0); frame < pileUp.frames; ++frame) {
+        Bench::populate(pileUp);
+        nMessages = 0;
+        Bench::step(pileUp.dt);
+
+        // the messages are relayed in the pass after the collision system's wave
+        double relayTime(tasks[collisionTask].messagingDT);
+        countSamples.add(double(nMessages));
+        if (nMessages) {
+            perMessageSamples.add(relayTime / double(nMessages));
+        }
+        totalMessages += double(nMessages);
+        totalRelayTime += relayTime;
+    }
+    Scene::removeReceiver(receiver);
+
+    std::cout << pileUp.enemies << " enemies, "
+        << countSamples.mean() << " CollisionMessages per frame (p99 " << countSamples.percentile(99.0) << "), "
+        << (totalRelayTime > 0.0 ? totalMessages / totalRelayTime : 0.0) << " relayed per second" << std::endl;
+
+    Bench::printHeader("Collision messaging pass, per CollisionMessage", true);
+    Bench::printRow("CollisionMessage", perMessageSamples, true);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
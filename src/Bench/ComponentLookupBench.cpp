@@ -0,0 +1,70 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Util/Util.hpp"
+#include "Component/CollisionComponents/BounderComponent.hpp"
+#include "Component/EnemyComponents/EnemyComponent.hpp"
+#include "Component/PlayerComponents/PlayerComponent.hpp"
+#include "Component/StatComponents/StatComponents.hpp"
+
+
+
+int componentLookupBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    // the objects hit in each collision, as seen by the game's collision receivers
+    Vector<const GameObject *> hitObjects;
+    auto collisionCallback([&](const CollisionMessage & msg) {
+        hitObjects.push_back(&msg.bounder2.gameObject());
+    });
+    ReceiverHandle receiver(Scene::addReceiver<CollisionMessage>(nullptr, collisionCallback));
+
+    // each hit is looked up several times, so the timer doesn't dominate
+    const int k_repeats(16);
+    Samples samples;
+    int nFound(0);
+    for (int frame(0); frame < options.frames; ++frame) {
+        Bench::populate(options);
+        hitObjects.clear();
+        Bench::step(options.dt);
+        if (hitObjects.empty()) {
+            continue;
+        }
+
+        // the same lookups BulletComponent makes on every collision
+        int nLookups(0);
+        Util::Stopwatch watch;
+        for (int r(0); r < k_repeats; ++r) {
+            for (const GameObject * obj : hitObjects) {
+                ++nLookups;
+                if (!obj->getComponentByType<HealthComponent>()) {
+                    continue;
+                }
+                ++nLookups;
+                if (obj->getComponentByType<EnemyComponent>()) {
+                    ++nFound;
+                    continue;
+                }
+                ++nLookups;
+                if (obj->getComponentByType<PlayerComponent>()) {
+                    ++nFound;
+                }
+            }
+        }
+        samples.add(watch.total() / double(nLookups));
+    }
+    Scene::removeReceiver(receiver);
+
+    std::cout << samples.count() << " frames with collisions, " << nFound << " characters found" << std::endl;
+
+    Bench::printHeader("getComponentByType in collision receivers, per call", true);
+    Bench::printRow("getComponentByType", samples, true);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
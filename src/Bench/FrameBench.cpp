@@ -0,0 +1,68 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Scene/Scheduler.hpp"
+#include "Util/JobSystem.hpp"
+#include "Component/EnemyComponents/EnemyComponent.hpp"
+#include "Component/WeaponComponents/ProjectileComponents.hpp"
+
+
+
+int frameBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    Vector<Samples> updateSamples(tasks.size());
+    Vector<Samples> messagingSamples(tasks.size());
+    Samples initSamples, killSamples, totalSamples;
+    Vector<Samples> allocationSamples(MemoryStats::k_nCategories);
+    double nEnemies(0.0), nProjectiles(0.0);
+
+    for (int frame(0); frame < options.frames; ++frame) {
+        Bench::populate(options);
+        Bench::step(options.dt);
+
+        for (int i(0); i < int(tasks.size()); ++i) {
+            updateSamples[i].add(tasks[i].updateDT);
+            messagingSamples[i].add(tasks[i].messagingDT);
+        }
+        initSamples.add(Scene::initDT);
+        killSamples.add(Scene::killDT);
+        totalSamples.add(Scene::totalDT);
+        for (int c(0); c < MemoryStats::k_nCategories; ++c) {
+            allocationSamples[c].add(double(MemoryStats::total(MemoryCategory(c)).frameAllocations));
+        }
+        nEnemies += double(Scene::getComponents<EnemyComponent>().size());
+        nProjectiles += double(Scene::getComponents<ProjectileComponent>().size());
+    }
+
+    std::cout << options.frames << " frames of " << options.dt << "s, "
+        << nEnemies / options.frames << " enemies and "
+        << nProjectiles / options.frames << " projectiles on average, "
+        << JobSystem::threadCount() << " threads" << std::endl;
+
+    Bench::printHeader("Frame");
+    Bench::printRow("Init", initSamples);
+    for (int i(0); i < int(tasks.size()); ++i) {
+        Bench::printRow(tasks[i].name, updateSamples[i]);
+        Bench::printRow(tasks[i].name + " messaging", messagingSamples[i]);
+    }
+    Bench::printRow("Kill", killSamples);
+    Bench::printRow("Total", totalSamples);
+
+#ifdef TRACK_MEMORY
+    // frame arena allocations are the ones that would otherwise hit the heap
+    Bench::printCountHeader("Allocations per frame");
+    for (int c(0); c < MemoryStats::k_nCategories; ++c) {
+        Bench::printCountRow(MemoryStats::name(MemoryCategory(c)), allocationSamples[c]);
+    }
+#endif
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
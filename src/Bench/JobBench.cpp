@@ -0,0 +1,102 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "Scene/Scene.hpp"
+#include "System/ParticleSystem.hpp"
+#include "Util/JobSystem.hpp"
+#include "Util/Util.hpp"
+#include "Component/SpatialComponents/SpatialComponent.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
+#include "Component/ParticleComponents/ParticleComponent.hpp"
+
+
+
+namespace {
+
+// Updates every component, serially or with the job system, once per frame
+template <typename CompT>
+Samples timeUpdates(const Vector<CompT *> & comps, const BenchOptions & options, int grainSize, bool parallel) {
+    Samples samples;
+    for (int frame(0); frame < options.frames; ++frame) {
+        Util::Stopwatch watch;
+        if (parallel) {
+            JobSystem::parallelFor(0, int(comps.size()), grainSize, [&](int i) {
+                comps[i]->update(options.dt);
+            });
+        }
+        else {
+            for (CompT * comp : comps) {
+                comp->update(options.dt);
+            }
+        }
+        samples.add(watch.total());
+    }
+    return samples;
+}
+
+}
+
+
+
+int jobBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    // fountains are the biggest particle emitters, and they never remove
+    // themselves, which isn't safe to do from a job
+    int nBodies(options.count > 0 ? options.count : 10000);
+    int nFountains(std::max(nBodies / 100, 1));
+    Vector<ParticleComponent *> particles;
+    Vector<NewtonianComponent *> newtonians;
+    for (int i(0); i < nFountains; ++i) {
+        GameObject & obj(Scene::createGameObject());
+        SpatialComponent & spatial(Scene::addComponent<SpatialComponent>(obj, glm::vec3(Util::random(-50.0f, 50.0f), 0.0f, Util::random(-150.0f, 0.0f))));
+        particles.push_back(&ParticleSystem::addWaterFountainPC(spatial));
+    }
+    for (int i(0); i < nBodies; ++i) {
+        GameObject & obj(Scene::createGameObject());
+        Scene::addComponent<SpatialComponent>(obj, glm::vec3(Util::random(-50.0f, 50.0f), Util::random(0.0f, 20.0f), Util::random(-150.0f, 0.0f)));
+        NewtonianComponent & newtonian(Scene::addComponent<NewtonianComponent>(obj, false));
+        newtonian.setVelocity(glm::vec3(Util::random(-5.0f, 5.0f), Util::random(0.0f, 5.0f), Util::random(-5.0f, 5.0f)));
+        newtonians.push_back(&newtonian);
+    }
+    // initializes them, then lets the fountains fill up
+    Bench::step(options.dt);
+    BenchOptions warmUp(options);
+    warmUp.frames = int(3.0f / options.dt);
+    timeUpdates(particles, warmUp, 1, false);
+
+    int nParticles(0);
+    for (ParticleComponent * comp : particles) {
+        nParticles += comp->count();
+    }
+    std::cout << nFountains << " fountains with " << nParticles << " particles, " << nBodies << " newtonians" << std::endl;
+
+    Bench::printHeader("Particle and newtonian updates");
+    Bench::printRow("Particle serial", timeUpdates(particles, options, 1, false));
+    Bench::printRow("Newtonian serial", timeUpdates(newtonians, options, 256, false));
+    Samples integrateSamples;
+    for (int frame(0); frame < options.frames; ++frame) {
+        Util::Stopwatch watch;
+        NewtonianComponent::integrate(newtonians, options.dt);
+        integrateSamples.add(watch.total());
+    }
+    Bench::printRow("Newtonian integrate", integrateSamples);
+
+    int maxThreads(std::max(int(std::thread::hardware_concurrency()), 1));
+    for (int nThreads(1); nThreads <= maxThreads; ++nThreads) {
+        JobSystem::shutDown();
+        JobSystem::init(nThreads - 1);
+        String threads(String(" ") + std::to_string(nThreads).c_str() + (nThreads == 1 ? " thread" : " threads"));
+        Bench::printRow("Particle" + threads, timeUpdates(particles, options, 1, true));
+        Bench::printRow("Newtonian" + threads, timeUpdates(newtonians, options, 256, true));
+    }
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
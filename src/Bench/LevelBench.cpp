@@ -0,0 +1,75 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "EngineApp/EngineApp.hpp"
+#include "Loader/Loader.hpp"
+#include "Scene/Scene.hpp"
+#include "Util/Util.hpp"
+
+
+
+namespace {
+
+const char * const k_levels[] = { "GameLevel_02.json", "GameLevel_03.json" };
+
+// Resident set size of the process in MB, or 0 where /proc isn't available
+double residentMB() {
+    std::ifstream statm("/proc/self/statm");
+    long pages(0), residentPages(0);
+    if (!(statm >> pages >> residentPages)) {
+        return 0.0;
+    }
+    return double(residentPages) * 4096.0 / (1024.0 * 1024.0);
+}
+
+}
+
+
+
+int levelBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    const int nLevels(int(sizeof(k_levels) / sizeof(k_levels[0])));
+    int nLoads(options.count > 0 ? options.count : 10);
+    Samples loadSamples[nLevels], initSamples[nLevels], residentSamples[nLevels];
+    for (int l(0); l < nLevels; ++l) {
+        for (int i(0); i < nLoads; ++i) {
+            // the frame after unloading is the one that rewinds the level regions
+            Scene::unloadLevel();
+            Bench::step(options.dt);
+            double before(residentMB());
+
+            Util::Stopwatch watch;
+            if (Loader::loadLevel(EngineApp::RESOURCE_DIR + k_levels[l])) {
+                Bench::tearDown();
+                return EXIT_FAILURE;
+            }
+            loadSamples[l].add(watch.lap());
+            // adds the level's objects to the scene
+            Bench::step(options.dt);
+            initSamples[l].add(watch.lap());
+            residentSamples[l].add(residentMB() - before);
+        }
+    }
+
+    // the first load also reads meshes from disk and sizes the level regions,
+    // so shows up in p99
+    std::cout << nLoads << " loads of each level" << std::endl;
+    Bench::printHeader("Level load");
+    for (int l(0); l < nLevels; ++l) {
+        Bench::printRow(String(k_levels[l]) + " load", loadSamples[l]);
+        Bench::printRow(String(k_levels[l]) + " first frame", initSamples[l]);
+    }
+    Bench::printCountHeader("RSS growth per load (MB)");
+    for (int l(0); l < nLevels; ++l) {
+        Bench::printCountRow(k_levels[l], residentSamples[l]);
+    }
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
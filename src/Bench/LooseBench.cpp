@@ -0,0 +1,109 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "System/GameInterface.hpp"
+#include "Util/Octree.hpp"
+#include "Util/Util.hpp"
+#include "Component/CollisionComponents/BounderComponent.hpp"
+
+
+
+namespace {
+
+const float k_loosenesses[] = { 1.0f, 1.5f, 2.0f };
+const int k_nLoosenesses(sizeof(k_loosenesses) / sizeof(*k_loosenesses));
+const int k_nRays(256);
+
+struct Results {
+    Samples overlapTested, overlapTimes, rayTested, rayTimes;
+};
+
+}
+
+
+
+int looseBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+    Bench::populate(options);
+    Bench::step(options.dt);
+
+    // all of them, level included, as the game's octree held them before the
+    // level went in its own hierarchy
+    const Vector<BounderComponent *> & bounders(Scene::getComponents<BounderComponent>());
+    Vector<UniquePtr<Octree<const BounderComponent *>>> octrees;
+    for (float looseness : k_loosenesses) {
+        // same as the game sets up for GameLevel_03
+        octrees.push_back(UniquePtr<Octree<const BounderComponent *>>::make(AABox(glm::vec3(-70.0f, -10.0f, -210.0f), glm::vec3(70.0f, 50.0f, 40.0f)), 1.0f, looseness));
+    }
+
+    Results results[k_nLoosenesses];
+    Vector<const BounderComponent *> found;
+    Vector<Ray> rays(k_nRays);
+    for (int frame(0); frame < options.frames; ++frame) {
+        Bench::populate(options);
+        Bench::step(options.dt);
+
+        for (int i(0); i < k_nRays; ++i) {
+            glm::vec3 pos(GameInterface::randomSpawnPoint() + glm::vec3(0.0f, Util::random(0.5f, 4.0f), 0.0f));
+            glm::vec3 dir(Util::random(-1.0f, 1.0f), Util::random(-0.5f, 0.5f), Util::random(-1.0f, 1.0f));
+            rays[i] = Ray(pos, Util::safeNorm(dir));
+        }
+
+        for (int l(0); l < k_nLoosenesses; ++l) {
+            Octree<const BounderComponent *> & octree(*octrees[l]);
+            // refilled with whatever's there this frame
+            octree.clear();
+            for (const BounderComponent * bounder : bounders) {
+                octree.set(bounder, bounder->enclosingAABox());
+            }
+
+            // what the collision system does for each bounder it checks
+            size_t nTested(0);
+            Util::Stopwatch watch;
+            for (const BounderComponent * bounder : bounders) {
+                found.clear();
+                nTested += octree.filter(bounder, found);
+            }
+            results[l].overlapTimes.add(watch.lap() / double(bounders.size()));
+            results[l].overlapTested.add(double(nTested) / double(bounders.size()));
+
+            // and for each pick
+            size_t nIntersected(0);
+            std::function<Intersect(const Ray &, const BounderComponent *)> f([&](const Ray & ray, const BounderComponent * bounder) {
+                ++nIntersected;
+                Intersect inter(bounder->intersect(ray));
+                return inter.face ? inter : Intersect();
+            });
+            watch.lap();
+            for (const Ray & ray : rays) {
+                octree.filter(ray, f);
+            }
+            results[l].rayTimes.add(watch.lap() / double(k_nRays));
+            results[l].rayTested.add(double(nIntersected) / double(k_nRays));
+        }
+    }
+
+    std::cout << bounders.size() << " bounders in GameLevel_03 with " << options.enemies << " enemies and " << options.projectiles << " projectiles" << std::endl;
+
+    Bench::printCountHeader("Elements tested per Octree::filter call");
+    for (int l(0); l < k_nLoosenesses; ++l) {
+        String name(String("k = ") + std::to_string(k_loosenesses[l]).substr(0, 3).c_str());
+        Bench::printCountRow(name + ", bounder overlap", results[l].overlapTested);
+        Bench::printCountRow(name + ", ray", results[l].rayTested);
+    }
+
+    Bench::printHeader("Octree::filter, per call", true);
+    for (int l(0); l < k_nLoosenesses; ++l) {
+        String name(String("k = ") + std::to_string(k_loosenesses[l]).substr(0, 3).c_str());
+        Bench::printRow(name + ", bounder overlap", results[l].overlapTimes, true);
+        Bench::printRow(name + ", ray", results[l].rayTimes, true);
+    }
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+#include "Bench.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Scene/Scheduler.hpp"
+#include "Util/Util.hpp"
+#include "Component/SpatialComponents/SpatialComponent.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
+#include "Component/CollisionComponents/BounderComponent.hpp"
+
+
+
+namespace {
+
+int findTask(const Vector<Scheduler::Task> & tasks, const char * name) {
+    int i(0);
+    while (i < int(tasks.size()) && tasks[i].name != name) {
+        ++i;
+    }
+    assert(i < int(tasks.size()));
+    return i;
+}
+
+}
+
+
+
+int moverBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    // no gravity, so they keep moving, bouncing off the level and each other
+    int nMovers(options.count > 0 ? options.count : 5000);
+    for (int i(0); i < nMovers; ++i) {
+        GameObject & obj(Scene::createGameObject());
+        Scene::addComponent<SpatialComponent>(obj, glm::vec3(Util::random(-50.0f, 50.0f), Util::random(1.0f, 20.0f), Util::random(-150.0f, 0.0f)));
+        NewtonianComponent & newtonian(Scene::addComponent<NewtonianComponent>(obj, true));
+        newtonian.setVelocity(glm::vec3(Util::random(-5.0f, 5.0f), Util::random(-5.0f, 5.0f), Util::random(-5.0f, 5.0f)));
+        Scene::addComponentAs<SphereBounderComponent, BounderComponent>(obj, 1, Sphere(glm::vec3(), 0.5f));
+    }
+    // initializes them
+    Bench::step(options.dt);
+
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    int spatialTask(findTask(tasks, "Spatial")), collisionTask(findTask(tasks, "Collision"));
+
+    Samples startSamples, spatialSamples, collisionSamples;
+    for (int frame(0); frame < options.frames; ++frame) {
+        Bench::step(options.dt);
+        startSamples.add(double(Scene::initDT));
+        spatialSamples.add(double(tasks[spatialTask].updateDT));
+        collisionSamples.add(double(tasks[collisionTask].updateDT));
+    }
+
+    std::cout << nMovers << " movers, " << sizeof(SpatialComponent) << " bytes per SpatialComponent" << std::endl;
+
+    Bench::printHeader("Moving objects, per frame");
+    Bench::printRow("Frame start (spatial rollover)", startSamples);
+    Bench::printRow("Spatial system", spatialSamples);
+    Bench::printRow("Collision system", collisionSamples);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
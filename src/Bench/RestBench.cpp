@@ -0,0 +1,91 @@
+#include "Bench.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "glm/gtc/constants.hpp"
+
+#include "Scene/Scene.hpp"
+#include "Scene/Scheduler.hpp"
+#include "System/GameInterface.hpp"
+#include "System/SpatialSystem.hpp"
+#include "Util/Util.hpp"
+#include "Component/EnemyComponents/EnemyComponent.hpp"
+#include "Component/SpatialComponents/SpatialComponent.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
+
+
+
+namespace {
+
+// Runs the frames, timing the collision system and counting who's asleep
+void run(const BenchOptions & options, int collisionTask, Samples & r_collisionSamples, Samples & r_asleepSamples) {
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    const Vector<NewtonianComponent *> & newtonians(Scene::getComponentsOfType<NewtonianComponent>());
+    for (int frame(0); frame < options.frames; ++frame) {
+        GameInterface::restorePlayer();
+        Bench::step(options.dt);
+        r_collisionSamples.add(double(tasks[collisionTask].updateDT));
+        int nAsleep(0);
+        for (const NewtonianComponent * newtonian : newtonians) {
+            nAsleep += newtonian->isAsleep();
+        }
+        r_asleepSamples.add(double(nAsleep));
+    }
+}
+
+}
+
+
+
+int restBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    // they're dropped in a crowd around the player and all chase it, so most
+    // end up blocked by the ones in front of them, pushing without moving
+    int nEnemies(options.count > 0 ? options.count : 300);
+    glm::vec3 playerPos(GameInterface::getPlayer().getSpatial()->position());
+    for (int i(0); i < nEnemies; ++i) {
+        float angle(Util::random() * 2.0f * glm::pi<float>()), dist(Util::random(2.0f, 12.0f));
+        GameInterface::spawnEnemy(playerPos + glm::vec3(std::cos(angle) * dist, 0.0f, std::sin(angle) * dist));
+    }
+
+    const Vector<Scheduler::Task> & tasks(Scheduler::tasks());
+    int collisionTask(0);
+    while (collisionTask < int(tasks.size()) && tasks[collisionTask].name != "Collision") {
+        ++collisionTask;
+    }
+    assert(collisionTask < int(tasks.size()));
+
+    // lets them land and close in before each run
+    BenchOptions settle(options);
+    settle.frames = int(5.0f / options.dt);
+    Samples ignored, ignoredAsleep;
+
+    Samples awakeSamples, awakeCountSamples;
+    SpatialSystem::setSleepEnabled(false);
+    run(settle, collisionTask, ignored, ignoredAsleep);
+    run(options, collisionTask, awakeSamples, awakeCountSamples);
+
+    Samples sleepSamples, sleepCountSamples;
+    SpatialSystem::setSleepEnabled(true);
+    run(settle, collisionTask, ignored, ignoredAsleep);
+    run(options, collisionTask, sleepSamples, sleepCountSamples);
+
+    std::cout << nEnemies << " enemies, " << Scene::getComponentsOfType<EnemyComponent>().size() << " of them left" << std::endl;
+
+    Bench::printHeader("Collision system, per frame");
+    Bench::printRow("Sleeping off", awakeSamples);
+    Bench::printRow("Sleeping on", sleepSamples);
+
+    Bench::printCountHeader("Newtonians asleep");
+    Bench::printCountRow("Sleeping off", awakeCountSamples);
+    Bench::printCountRow("Sleeping on", sleepCountSamples);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
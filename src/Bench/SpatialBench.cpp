@@ -0,0 +1,45 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "Util/Util.hpp"
+#include "Component/SpatialComponents/SpatialComponent.hpp"
+
+
+
+int spatialBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    int nSpatials(options.count > 0 ? options.count : 100000);
+    for (int i(0); i < nSpatials; ++i) {
+        GameObject & obj(Scene::createGameObject());
+        Scene::addComponent<SpatialComponent>(obj, glm::vec3(Util::random(-100.0f, 100.0f), Util::random(0.0f, 10.0f), Util::random(-200.0f, 50.0f)));
+    }
+    // initializes them
+    Bench::step(options.dt);
+
+    const Vector<SpatialComponent *> & spatials(Scene::getComponents<SpatialComponent>());
+    Samples samples;
+    glm::vec3 sum;
+    for (int frame(0); frame < options.frames; ++frame) {
+        Util::Stopwatch watch;
+        for (SpatialComponent * spatial : spatials) {
+            spatial->update(options.dt);
+            sum += spatial->position();
+        }
+        samples.add(watch.total() / double(spatials.size()));
+    }
+
+    // printed so the loop isn't optimized away
+    std::cout << spatials.size() << " spatials, position sum " << sum.x + sum.y + sum.z << std::endl;
+
+    Bench::printHeader("Spatial update and position, per component", true);
+    Bench::printRow("SpatialComponent", samples, true);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Scene/Scene.hpp"
+#include "System/GameInterface.hpp"
+#include "Util/BVH.hpp"
+#include "Util/Octree.hpp"
+#include "Util/Util.hpp"
+#include "Component/CollisionComponents/BounderComponent.hpp"
+
+
+
+namespace {
+
+// Queries are timed in batches, so the timer doesn't dominate
+const int k_batchSize(256);
+
+bool overlaps(const AABox & b1, const AABox & b2) {
+    return
+        b1.min.x <= b2.max.x && b2.min.x <= b1.max.x &&
+        b1.min.y <= b2.max.y && b2.min.y <= b1.max.y &&
+        b1.min.z <= b2.max.z && b2.min.z <= b1.max.z;
+}
+
+Intersect intersectFace(const Ray & ray, const BounderComponent * bounder) {
+    Intersect inter(bounder->intersect(ray));
+    return inter.face ? inter : Intersect();
+}
+
+}
+
+
+
+int staticsBench(const BenchOptions & options) {
+    if (!Bench::setUp(options)) {
+        return EXIT_FAILURE;
+    }
+
+    // the level's bounders, in an octree set up as the game sets it up and in
+    // a BVH
+    Vector<std::pair<const BounderComponent *, AABox>> statics;
+    for (const BounderComponent * bounder : Scene::getComponents<BounderComponent>()) {
+        if (bounder->isStatic()) {
+            statics.emplace_back(bounder, bounder->enclosingAABox());
+        }
+    }
+    Octree<const BounderComponent *> octree(AABox(glm::vec3(-70.0f, -10.0f, -210.0f), glm::vec3(70.0f, 50.0f, 40.0f)), 1.0f);
+    Util::Stopwatch watch;
+    for (const auto & pair : statics) {
+        octree.set(pair.first, pair.second);
+    }
+    double octreeBuildTime(watch.lap());
+    BVH<const BounderComponent *> bvh;
+    bvh.build(statics);
+    double bvhBuildTime(watch.lap());
+
+    Samples octreeRaySamples, bvhRaySamples, octreeOverlapSamples, bvhOverlapSamples;
+    Vector<Ray> rays(k_batchSize);
+    Vector<AABox> regions(k_batchSize);
+    Vector<const BounderComponent *> results;
+    int nMismatches(0);
+    size_t nOctreeOverlaps(0), nBVHOverlaps(0);
+    std::function<Intersect(const Ray &, const BounderComponent *)> f(intersectFace);
+    for (int frame(0); frame < options.frames; ++frame) {
+        // from around where characters stand, in any direction, and regions
+        // about the size of a character
+        for (int i(0); i < k_batchSize; ++i) {
+            glm::vec3 pos(GameInterface::randomSpawnPoint() + glm::vec3(Util::random(-4.0f, 4.0f), Util::random(0.5f, 4.0f), Util::random(-4.0f, 4.0f)));
+            glm::vec3 dir(Util::random(-1.0f, 1.0f), Util::random(-1.0f, 1.0f), Util::random(-1.0f, 1.0f));
+            rays[i] = Ray(pos, Util::safeNorm(dir));
+            glm::vec3 radius(Util::random(0.5f, 2.0f));
+            regions[i] = AABox(pos - radius, pos + radius);
+        }
+
+        float octreeDists(0.0f), bvhDists(0.0f);
+        watch.lap();
+        for (const Ray & ray : rays) {
+            octreeDists += octree.filter(ray, f).second.dist;
+        }
+        octreeRaySamples.add(watch.lap() / k_batchSize);
+        for (const Ray & ray : rays) {
+            bvhDists += bvh.filter(ray, f).second.dist;
+        }
+        bvhRaySamples.add(watch.lap() / k_batchSize);
+        nMismatches += octreeDists != bvhDists;
+
+        // the octree gives everything in the nodes the region touches, so
+        // what it gives is narrowed down to real overlaps like the BVH's
+        for (const AABox & region : regions) {
+            results.clear();
+            octree.filter(region, results);
+            for (const BounderComponent * bounder : results) {
+                nOctreeOverlaps += overlaps(region, bounder->enclosingAABox());
+            }
+        }
+        octreeOverlapSamples.add(watch.lap() / k_batchSize);
+        for (const AABox & region : regions) {
+            results.clear();
+            nBVHOverlaps += bvh.filter(region, results);
+        }
+        bvhOverlapSamples.add(watch.lap() / k_batchSize);
+    }
+
+    std::cout << statics.size() << " static bounders, built in " << octreeBuildTime * 1.0e3 << " ms as an octree and " << bvhBuildTime * 1.0e3 << " ms as a BVH" << std::endl;
+    std::cout << nMismatches << " batches of rays where the two disagree, " << nOctreeOverlaps << " overlaps found by the octree and " << nBVHOverlaps << " by the BVH" << std::endl;
+
+    Bench::printHeader("Static geometry queries, per query", true);
+    Bench::printRow("Ray, octree", octreeRaySamples, true);
+    Bench::printRow("Ray, BVH", bvhRaySamples, true);
+    Bench::printRow("Overlap, octree", octreeOverlapSamples, true);
+    Bench::printRow("Overlap, BVH", bvhOverlapSamples, true);
+
+    Bench::tearDown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "Bench.hpp"
+#include "EngineApp/EngineApp.hpp"
+#include "Util/Profiler.hpp"
+
+
+
+struct Scenario {
+    const char * name;
+    int (*run)(const BenchOptions &);
+    const char * description;
+};
+
+const Scenario k_scenarios[] = {
+    { "frame",     frameBench,            "whole frames, per scheduler task" },
+    { "spatial",   spatialBench,          "SpatialComponent iteration, per component (-n spatials)" },
+    { "lookup",    componentLookupBench,  "getComponentByType in collision receivers, per call" },
+    { "collision", collisionMessageBench, "CollisionMessage throughput in a pile-up (-n enemies)" },
+    { "jobs",      jobBench,              "particle and newtonian updates on 1 to N threads (-n newtonians)" },
+    { "batch",     batchBench,            "virtual against batched component updates (-n objects)" },
+    { "level",     levelBench,            "level load time and RSS growth, reloading each level (-n loads)" },
+    { "movers",    moverBench,            "spatial and collision updates with every object moving (-n objects)" },
+    { "rest",      restBench,             "collision with most enemies blocked in place, with and without sleeping (-n enemies)" },
+    { "broadphase", broadphaseBench,      "collision with the octree against sweep and prune, 100 to 5000 capsules (-n max capsules)" },
+    { "statics",   staticsBench,          "ray and overlap queries on level geometry, octree against BVH" },
+    { "loose",     looseBench,            "elements tested per octree query, tight and loose (-e enemies, -p projectiles)" },
+};
+
+void printUsage() {
+    std::cout << "Usage: BattleRoyaleBench [scenario] [args]" << std::endl;
+
+    std::cout << "Scenarios: " << std::endl;
+    for (const Scenario & scenario : k_scenarios) {
+        std::cout << "\t" << scenario.name << "\n\t\t" << scenario.description << std::endl;
+    }
+
+    std::cout << "Valid arguments: " << std::endl;
+
+    std::cout << "\t-h\n\t\tPrint help" << std::endl;
+
+    std::cout << "\t-v\n\t\tSet verbose nature logging" << std::endl;
+
+    std::cout << "\t-r <resource_dir>" << std::endl;
+    std::cout << "\t\tSet the resource directory" << std::endl;
+
+    std::cout << "\t-f <frames>" << std::endl;
+    std::cout << "\t\tNumber of frames to run" << std::endl;
+
+    std::cout << "\t-d <seconds>" << std::endl;
+    std::cout << "\t\tFixed time step of each frame" << std::endl;
+
+    std::cout << "\t-e <enemies>" << std::endl;
+    std::cout << "\t\tNumber of enemies to keep alive" << std::endl;
+
+    std::cout << "\t-p <projectiles>" << std::endl;
+    std::cout << "\t\tNumber of projectiles to keep in the air" << std::endl;
+
+    std::cout << "\t-n <count>" << std::endl;
+    std::cout << "\t\tScenario specific number of objects" << std::endl;
+
+    std::cout << "\t-t <threads>" << std::endl;
+    std::cout << "\t\tNumber of threads running jobs, including the main thread" << std::endl;
+
+    std::cout << "\t-s <seed>" << std::endl;
+    std::cout << "\t\tRandom seed" << std::endl;
+
+    std::cout << "\t-m <csv_file>" << std::endl;
+    std::cout << "\t\tWrite allocations per memory category each frame, if built with TRACK_MEMORY" << std::endl;
+
+    std::cout << "\t-x <trace_file>" << std::endl;
+    std::cout << "\t\tProfile the run and write its last frames as a Chrome trace" << std::endl;
+}
+
+int parseArgs(int argc, char **argv, const Scenario * & r_scenario, BenchOptions & r_options) {
+    for (int i = 1; i < argc; i++) {
+        /* Help */
+        if (!strcmp(argv[i], "-h")) {
+            printUsage();
+            return 1;
+        }
+        /* Verbose */
+        if (!strcmp(argv[i], "-v")) {
+            EngineApp::verbose = true;
+            continue;
+        }
+        /* Scenario */
+        if (argv[i][0] != '-') {
+            r_scenario = nullptr;
+            for (const Scenario & scenario : k_scenarios) {
+                if (!strcmp(argv[i], scenario.name)) {
+                    r_scenario = &scenario;
+                }
+            }
+            if (!r_scenario) {
+                printUsage();
+                return 1;
+            }
+            continue;
+        }
+        /* Everything else takes a value */
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        const char * value(argv[++i]);
+        switch (argv[i - 1][1]) {
+            case 'r': EngineApp::RESOURCE_DIR = value; break;
+            case 'f': r_options.frames = std::atoi(value); break;
+            case 'd': r_options.dt = float(std::atof(value)); break;
+            case 'e': r_options.enemies = std::atoi(value); break;
+            case 'p': r_options.projectiles = std::atoi(value); break;
+            case 'n': r_options.count = std::atoi(value); break;
+            case 't': r_options.threads = std::atoi(value); break;
+            case 's': r_options.seed = (unsigned int)(std::atoi(value)); break;
+            case 'm': r_options.memoryCSV = value; break;
+            case 'x': r_options.trace = value; break;
+            default: printUsage(); return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const Scenario * scenario(&k_scenarios[0]);
+    BenchOptions options;
+    if (parseArgs(argc, argv, scenario, options)) {
+        return EXIT_FAILURE;
+    }
+
+    if (options.trace.empty()) {
+        return scenario->run(options);
+    }
+
+    // zones outlive the engine, so can be written once the scenario is done
+    Profiler::setEnabled(true);
+    int rc(scenario->run(options));
+    Profiler::setEnabled(false);
+    if (!Profiler::writeChromeTrace(options.trace, options.frames)) {
+        return EXIT_FAILURE;
+    }
+    return rc;
+}
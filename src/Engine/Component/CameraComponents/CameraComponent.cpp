@@ -48,7 +48,7 @@ void CameraComponent::init() {
     if (m_spatial) assert(&m_spatial->gameObject() == &gameObject());
     else assert(m_spatial = gameObject().getSpatial());
 
-    auto spatChangeCallback([&](const Message & msg_) {
+    auto spatChangeCallback([&](const Message &) {
         m_viewMatValid = false;
         m_frustumValid = false;
     });
@@ -56,7 +56,7 @@ void CameraComponent::init() {
     Scene::addReceiver<CollisionAdjustMessage>(&gameObject(), spatChangeCallback); // necessary as collision sets position silently
 
     if (!m_isOrtho) {
-        auto windowSizeCallback([&] (const Message & msg_) {
+        auto windowSizeCallback([&](const WindowFrameSizeMessage &) {
             m_projMatValid = false;
             m_frustumValid = false;
         });
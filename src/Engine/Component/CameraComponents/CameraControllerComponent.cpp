@@ -23,10 +23,9 @@ CameraControllerComponent::CameraControllerComponent(GameObject & gameObject, fl
 void CameraControllerComponent::init() {
     if (!(m_spatial = gameObject().getSpatial())) assert(false);
 
-    auto scrollCallback([&](const Message & msg_) {
+    auto scrollCallback([&](const ScrollMessage & msg) {
         static float s_percentage = 0.5f;
 
-        const ScrollMessage & msg(static_cast<const ScrollMessage &>(msg_));
         if (!m_enabled) {
             return;
         }
@@ -13,7 +13,8 @@ BounderComponent::BounderComponent(GameObject & gameObject, unsigned int weight,
     Component(gameObject),
     m_spatial(spatial),
     m_weight(weight),
-    m_isChange(false)
+    m_isChange(false),
+    m_isInStatics(false)
 {}
 
 void BounderComponent::init() {
@@ -63,6 +63,7 @@ class BounderComponent : public Component {
     const SpatialComponent * m_spatial;
     unsigned int m_weight;
     bool m_isChange;
+    bool m_isInStatics; // kept in the collision system's static hierarchy
 
 };
 
@@ -12,7 +12,7 @@ class Component {
 
     protected: // only scene or friends can create components
 
-        Component(GameObject & gameObject) : m_gameObject(&gameObject) {};
+        Component(GameObject & gameObject) : m_gameObject(&gameObject), m_sceneIndex(-1), m_poolID(-1), m_poolIndex(-1), m_isStatic(false), m_hasReceivers(false) {};
 
     public:
 
@@ -29,16 +29,30 @@ class Component {
 
     virtual void init() {}
 
+    // Called once the game object has been made static, after which update
+    // is no longer called. Should leave the component as it would be after
+    // any number of updates with nothing changing
+    virtual void settle() {}
+
     public:
         
         virtual void update(float) {};
 
         GameObject & gameObject() { return *m_gameObject; }
         const GameObject & gameObject() const { return *m_gameObject; }
+        // false once the game object has been destroyed, while the component waits to be
+        bool hasGameObject() const { return m_gameObject; }
+        // belongs to a static game object, so isn't updated
+        bool isStatic() const { return m_isStatic; }
 
     private:
 
         GameObject * m_gameObject;
+        int m_sceneIndex; // position in scene's component list, or -1 if not in the scene
+        int m_poolID; // type ID of the pool the component was allocated from
+        int m_poolIndex; // position in scene's list of components of its concrete type
+        bool m_isStatic;
+        bool m_hasReceivers; // added receivers during init that must go with it
 
 };
 
@@ -71,8 +71,7 @@ BasicEnemyComponent::BasicEnemyComponent(GameObject & gameObject, float meleeDam
 void BasicEnemyComponent::init() {
     EnemyComponent::init();
     
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         // Melee damage to player
         PlayerComponent * player;
         if (player = msg.bounder2.gameObject().getComponentByType<PlayerComponent>()) {
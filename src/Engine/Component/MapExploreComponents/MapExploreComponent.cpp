@@ -61,8 +61,7 @@ void MapExploreComponent::init() {
     m_cosCriticalAngle = std::cos(k_defCriticalAngle);
 
     // Function called when the object collides with something
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionNormMessage & msg(static_cast<const CollisionNormMessage &>(msg_));
+    auto collisionCallback([&](const CollisionNormMessage & msg) {
         float dot(glm::dot(msg.norm, -SpatialSystem::gravityDir()));
         if (dot >= m_cosCriticalAngle) {
         	nonGroundCollision = true;
@@ -21,10 +21,26 @@ class ParticleAssasinComponent : public Component {
 
         ParticleAssasinComponent(ParticleAssasinComponent && other) = default;
 
-        virtual void update(float dt) override {
+    protected:
+
+        // Rather than checking every frame, waits for the particle components
+        // to remove themselves
+        virtual void init() override {
+            auto removedCallback([&](const ComponentRemovedMessage & msg) {
+                if (msg.typeID == TypeIDs<Component>::get<ParticleComponent>()) {
+                    killIfDone();
+                }
+            });
+            Scene::addReceiver<ComponentRemovedMessage>(&gameObject(), removedCallback);
+            killIfDone();
+        }
+
+    private:
+
+        void killIfDone() {
             if (gameObject().getComponentsByType<ParticleComponent>().empty()) {
                 Scene::destroyGameObject(gameObject());
             }
         }
-        
+
 };
\ No newline at end of file
@@ -23,9 +23,6 @@ void PathfindingComponent::init() {
 
     if (!(m_bounder = gameObject().getComponentByType<BounderComponent>())) assert(false);
 
-    // init cameFrom map
-    cameFrom = PathfindingSystem::vecvecMap();
-
     const glm::vec3 &playerPos = m_player.getSpatial()->position();
     const glm::vec3 &pos = m_bounder->groundPosition();
 
@@ -63,6 +60,7 @@ void PathfindingComponent::update(float dt) {
     }
     // probably don't need to update the path everytime, set flag when neccessary
     else if (updatePath) {
+        PathfindingSystem::vecvecMap cameFrom;
         if (aStarSearch(PathfindingSystem::graph, pos, playerGroundPos, cameFrom)) {
             path = reconstructPath(pos, playerGroundPos, cameFrom);
             pathIT = path.begin();
@@ -116,7 +114,7 @@ bool operator != (glm::vec3 a, glm::vec3 b) {
 
 bool PathfindingComponent::aStarSearch(PathfindingSystem::vecvectorMap &graph, glm::vec3 start, glm::vec3 end, PathfindingSystem::vecvecMap &cameFrom) {
     PathfindingSystem::vecdoubleMap cost = PathfindingSystem::vecdoubleMap();
-    std::priority_queue<pathPair, Vector<pathPair>, std::greater<pathPair>> frontier;
+    std::priority_queue<pathPair, FrameVector<pathPair>, std::greater<pathPair>> frontier;
 
     start = PathfindingComponent::closestPos(graph, start);
     end = PathfindingComponent::closestPos(graph, end);
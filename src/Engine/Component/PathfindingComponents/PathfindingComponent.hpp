@@ -81,8 +81,7 @@ class PathfindingComponent : public Component {
     int pathCount;
     bool noPath = false;
 
-    PathfindingSystem::vecvecMap cameFrom;
     Vector<glm::vec3> path;
-    std::vector<glm::vec3>::iterator pathIT;
+    Vector<glm::vec3>::iterator pathIT;
 
 };
\ No newline at end of file
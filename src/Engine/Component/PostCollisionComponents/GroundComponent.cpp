@@ -3,6 +3,7 @@
 #include "glm/gtc/constants.hpp"
 
 #include "Scene/Scene.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
 #include "System/SpatialSystem.hpp"
 #include "Util/Util.hpp"
 
@@ -12,12 +13,14 @@ const float GroundComponent::k_defCriticalAngle = glm::pi<float>() * 0.25f; // 4
 
 GroundComponent::GroundComponent(GameObject & gameObject, float criticalAngle) :
     Component(gameObject),
+    m_newtonian(nullptr),
     m_cosCriticalAngle(std::cos(criticalAngle))
 {}
 
 void GroundComponent::init() {
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionNormMessage & msg(static_cast<const CollisionNormMessage &>(msg_));
+    m_newtonian = gameObject().getComponentByType<NewtonianComponent>();
+
+    auto collisionCallback([&](const CollisionNormMessage & msg) {
         float dot(glm::dot(msg.norm, -SpatialSystem::gravityDir()));
         if (dot >= m_cosCriticalAngle) {
             m_potentialGroundNorm += msg.norm;
@@ -27,6 +30,12 @@ void GroundComponent::init() {
 }
 
 void GroundComponent::update(float dt) {
+    // a sleeping body stops colliding, but is still on whatever it fell
+    // asleep on
+    if (m_newtonian && m_newtonian->isAsleep()) {
+        m_potentialGroundNorm = glm::vec3();
+        return;
+    }
     m_groundNorm = Util::safeNorm(m_potentialGroundNorm);
     m_potentialGroundNorm = glm::vec3();
 }
@@ -7,6 +7,7 @@
 
 
 class Scene;
+class NewtonianComponent;
 
 
 
@@ -47,6 +48,7 @@ class GroundComponent : public Component {
 
   protected:
 
+    const NewtonianComponent * m_newtonian; // if it has one
     float m_cosCriticalAngle; // cosine of most severe angle that can still be considered "ground"
     glm::vec3 m_groundNorm;
     glm::vec3 m_potentialGroundNorm;
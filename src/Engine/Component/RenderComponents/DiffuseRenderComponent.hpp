@@ -39,6 +39,13 @@ class DiffuseRenderComponent : public Component {
 
         DiffuseRenderComponent(DiffuseRenderComponent && other) = default;
 
+    protected:
+
+        // Transforms the bounds once, as the spatial won't change
+        virtual void settle() override { update(0.0f); }
+
+    public:
+
         virtual void update(float dt) override;
 
         const Mesh & mesh() const { return m_mesh; }
@@ -1,5 +1,7 @@
 #include "PhysicsComponents.hpp"
 
+#include <algorithm>
+
 #include "glm/gtx/norm.hpp"
 #include "glm/gtc/constants.hpp"
 
@@ -7,6 +9,67 @@
 #include "Scene/Scene.hpp"
 #include "System/SpatialSystem.hpp"
 #include "Util/Util.hpp"
+#include "Component/CollisionComponents/BounderComponent.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PHYSICS_SSE
+#include <xmmintrin.h>
+#endif
+
+
+
+namespace {
+
+constexpr int k_lanes = 4;
+
+// A block of newtonians laid out component-wise, so each lane of a vector
+// register holds one body
+struct IntegrateBlock {
+    alignas(16) float vx[k_lanes], vy[k_lanes], vz[k_lanes]; // velocity in, new velocity out
+    alignas(16) float ax[k_lanes], ay[k_lanes], az[k_lanes]; // acceleration in, delta out
+};
+
+// Same math as NewtonianComponent::update, and sqrt and division are exact
+// in SSE, so the results are the same
+void integrateBlock(IntegrateBlock & b, float dt) {
+#ifdef PHYSICS_SSE
+    __m128 t(_mm_set1_ps(dt)), halfT(_mm_set1_ps(0.5f * dt));
+    __m128 terminal(_mm_set1_ps(SpatialSystem::k_terminalVelocity));
+    __m128 terminal2(_mm_mul_ps(terminal, terminal));
+    __m128 vx(_mm_load_ps(b.vx)), vy(_mm_load_ps(b.vy)), vz(_mm_load_ps(b.vz));
+    __m128 nx(_mm_add_ps(vx, _mm_mul_ps(_mm_load_ps(b.ax), t)));
+    __m128 ny(_mm_add_ps(vy, _mm_mul_ps(_mm_load_ps(b.ay), t)));
+    __m128 nz(_mm_add_ps(vz, _mm_mul_ps(_mm_load_ps(b.az), t)));
+    __m128 speed2(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz)));
+    // lanes under terminal velocity keep a factor of 1
+    __m128 over(_mm_cmpgt_ps(speed2, terminal2));
+    __m128 factor(_mm_div_ps(terminal, _mm_sqrt_ps(speed2)));
+    factor = _mm_or_ps(_mm_and_ps(over, factor), _mm_andnot_ps(over, _mm_set1_ps(1.0f)));
+    nx = _mm_mul_ps(nx, factor);
+    ny = _mm_mul_ps(ny, factor);
+    nz = _mm_mul_ps(nz, factor);
+    _mm_store_ps(b.ax, _mm_mul_ps(halfT, _mm_add_ps(vx, nx)));
+    _mm_store_ps(b.ay, _mm_mul_ps(halfT, _mm_add_ps(vy, ny)));
+    _mm_store_ps(b.az, _mm_mul_ps(halfT, _mm_add_ps(vz, nz)));
+    _mm_store_ps(b.vx, nx);
+    _mm_store_ps(b.vy, ny);
+    _mm_store_ps(b.vz, nz);
+#else
+    for (int i(0); i < k_lanes; ++i) {
+        glm::vec3 velocity(b.vx[i], b.vy[i], b.vz[i]);
+        glm::vec3 newVelocity(velocity + glm::vec3(b.ax[i], b.ay[i], b.az[i]) * dt);
+        float speed2(glm::length2(newVelocity));
+        if (speed2 > SpatialSystem::k_terminalVelocity * SpatialSystem::k_terminalVelocity) {
+            newVelocity *= SpatialSystem::k_terminalVelocity / std::sqrt(speed2);
+        }
+        glm::vec3 delta(0.5f * dt * (velocity + newVelocity));
+        b.vx[i] = newVelocity.x; b.vy[i] = newVelocity.y; b.vz[i] = newVelocity.z;
+        b.ax[i] = delta.x; b.ay[i] = delta.y; b.az[i] = delta.z;
+    }
+#endif
+}
+
+}
 
 
 
@@ -15,15 +78,18 @@ NewtonianComponent::NewtonianComponent(GameObject & gameObject, bool isBouncy) :
     m_spatial(nullptr),
     m_velocity(),
     m_acceleration(),
-    m_isBouncy(isBouncy)
+    m_isBouncy(isBouncy),
+    m_isAsleep(false),
+    m_isMoving(true),
+    m_restFrames(0),
+    m_restPosition(),
+    m_restPush()
 {}
 
 void NewtonianComponent::init() {
     if (!(m_spatial = gameObject().getSpatial())) assert(false);
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionNormMessage & msg(static_cast<const CollisionNormMessage &>(msg_));
-
+    auto collisionCallback([&](const CollisionNormMessage & msg) {
         // Calculate "friction"
         float y(-glm::dot(m_velocity, msg.norm)); // speed into surface
         if (y <= 0.0) { // not trying to move into surface
@@ -51,9 +117,31 @@ void NewtonianComponent::init() {
         m_velocity = v * (1.0f - factor);
     });
     Scene::addReceiver<CollisionNormMessage>(&gameObject(), collisionCallback);
+
+    auto wakeCallback([&](const CollisionMessage & msg) {
+        if (!m_isAsleep) {
+            return;
+        }
+        const GameObject & other(msg.bounder2.gameObject());
+        if (other.isStatic()) {
+            return;
+        }
+        // one held in place against it leaves it be, so that a crowd blocked
+        // against itself can all drop off
+        const NewtonianComponent * newtonian(other.getComponentByType<NewtonianComponent>());
+        if (!newtonian || newtonian->isMoving()) {
+            wake();
+        }
+    });
+    Scene::addReceiver<CollisionMessage>(&gameObject(), wakeCallback);
+
+    m_restPosition = m_spatial->position();
 }
 
 void NewtonianComponent::update(float dt) {
+    if (updateSleep(dt)) {
+        return;
+    }
     glm::vec3 newVelocity(m_velocity + m_acceleration * dt);
     float speed2(glm::length2(newVelocity));
     if (speed2 > SpatialSystem::k_terminalVelocity *  SpatialSystem::k_terminalVelocity) {
@@ -67,24 +155,113 @@ void NewtonianComponent::update(float dt) {
     m_acceleration = glm::vec3();
 }
 
+void NewtonianComponent::integrate(const Vector<NewtonianComponent *> & newtonians, float dt) {
+    int n(int(newtonians.size()));
+    IntegrateBlock block;
+    NewtonianComponent * lanes[k_lanes];
+    int next(0);
+    while (next < n) {
+        // sleeping bodies are skipped, so blocks are filled with awake ones
+        int nLanes(0);
+        while (nLanes < k_lanes && next < n) {
+            NewtonianComponent * newtonian(newtonians[next++]);
+            if (!newtonian->updateSleep(dt)) {
+                lanes[nLanes++] = newtonian;
+            }
+        }
+        for (int i(0); i < k_lanes; ++i) {
+            // unused lanes of the last block integrate nothing
+            glm::vec3 velocity(i < nLanes ? lanes[i]->m_velocity : glm::vec3());
+            glm::vec3 acceleration(i < nLanes ? lanes[i]->m_acceleration : glm::vec3());
+            block.vx[i] = velocity.x; block.vy[i] = velocity.y; block.vz[i] = velocity.z;
+            block.ax[i] = acceleration.x; block.ay[i] = acceleration.y; block.az[i] = acceleration.z;
+        }
+
+        integrateBlock(block, dt);
+
+        // moving goes through the spatial, so it's marked changed as usual
+        for (int i(0); i < nLanes; ++i) {
+            NewtonianComponent & newtonian(*lanes[i]);
+            glm::vec3 delta(block.ax[i], block.ay[i], block.az[i]);
+            if (!Util::isZero(glm::length2(delta))) {
+                newtonian.m_spatial->move(delta);
+            }
+            newtonian.m_velocity = glm::vec3(block.vx[i], block.vy[i], block.vz[i]);
+            newtonian.m_acceleration = glm::vec3();
+        }
+    }
+}
+
 void NewtonianComponent::accelerate(const glm::vec3 & acceleration) {
     m_acceleration += acceleration;
 }
 
 void NewtonianComponent::addVelocity(const glm::vec3 & velocity) {
-    m_velocity += velocity;
+    if (velocity != glm::vec3()) {
+        m_velocity += velocity;
+        wake();
+    }
 }
 
 void NewtonianComponent::setVelocity(const glm::vec3 & velocity) {
-    m_velocity = velocity;
+    if (velocity != m_velocity) {
+        m_velocity = velocity;
+        wake();
+    }
 }
 
 void NewtonianComponent::removeAllVelocityAgainstDir(const glm::vec3 & dir) {
-    m_velocity = Util::removeAllAgainst(m_velocity, dir);
+    setVelocity(Util::removeAllAgainst(m_velocity, dir));
 }
 
 void NewtonianComponent::removeSomeVelocityAgainstDir(const glm::vec3 & dir, float amount) {
-    m_velocity = Util::removeSomeAgainst(m_velocity, dir, amount);
+    setVelocity(Util::removeSomeAgainst(m_velocity, dir, amount));
+}
+
+void NewtonianComponent::wake() {
+    m_isAsleep = false;
+    m_restFrames = 0;
+}
+
+bool NewtonianComponent::updateSleep(float dt) {
+    // where collision left it last frame, and how far it's been pushed since
+    // by anything but its own integration, like pathfinding
+    glm::vec3 settled(m_spatial->prevPosition());
+    glm::vec3 push(m_spatial->position() - settled);
+    // ending up in the same spot while pushed the same way means something is
+    // holding it in place, even if the push itself isn't small
+    float restDist(SpatialSystem::k_sleepSpeed * dt);
+    bool isHeld(
+        SpatialSystem::isSleepEnabled() &&
+        glm::length2(settled - m_restPosition) <= restDist * restDist &&
+        glm::length2(push - m_restPush) <= restDist * restDist
+    );
+
+    if (m_isAsleep && !isHeld) {
+        // something else moved it, or it's being pushed some new way
+        wake();
+    }
+    if (!m_isAsleep) {
+        float restSpeed(SpatialSystem::k_sleepSpeed);
+        m_isMoving = !isHeld || glm::length2(m_velocity) > restSpeed * restSpeed;
+        m_restFrames = m_isMoving ? 0 : m_restFrames + 1;
+        m_restPosition = settled;
+        m_restPush = push;
+        if (m_restFrames < SpatialSystem::k_sleepFrames) {
+            return false;
+        }
+        m_isAsleep = true;
+        m_velocity = glm::vec3();
+    }
+
+    // collision would only undo the push, so it's taken back here, and
+    // whatever it was being accelerated by is being held off
+    glm::vec3 position(m_spatial->position());
+    if (position != m_restPosition) {
+        m_spatial->move(m_restPosition - position, true);
+    }
+    m_acceleration = glm::vec3();
+    return true;
 }
 
 
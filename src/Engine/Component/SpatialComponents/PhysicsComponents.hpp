@@ -35,8 +35,15 @@ class NewtonianComponent : public Component {
 
     virtual void update(float dt) override;
 
+    // Does the same as calling update on each, four at a time with SSE where
+    // it's available
+    static void integrate(const Vector<NewtonianComponent *> & newtonians, float dt);
+
     void accelerate(const glm::vec3 & acceleration);
 
+    // Changing the velocity wakes the body, as does being moved or pushed
+    // differently than it was as it fell asleep, or being hit by something
+    // that's moving
     void addVelocity(const glm::vec3 & velocity);
 
     void setVelocity(const glm::vec3 & velocity);
@@ -48,12 +55,33 @@ class NewtonianComponent : public Component {
 
     const glm::vec3 & velocity() const { return m_velocity; }
 
+    // A body that has barely moved for SpatialSystem::k_sleepFrames frames,
+    // either sitting still or pushed against something that won't give, is
+    // put to sleep. It's left out of integration, any push is taken back,
+    // and it holds its ground against bodies no heavier than itself, so it's
+    // only checked for collisions from their side
+    bool isAsleep() const { return m_isAsleep; }
+    void wake();
+
+    // Whether it moved, or was pushed some new way, as of the last integration
+    bool isMoving() const { return m_isMoving; }
+
+  private:
+
+    // Puts the body to sleep or wakes it up. Returns whether it's asleep
+    bool updateSleep(float dt);
+
   protected:
 
     SpatialComponent * m_spatial;
     glm::vec3 m_velocity;
     glm::vec3 m_acceleration;
     bool m_isBouncy;
+    bool m_isAsleep;
+    bool m_isMoving;
+    int m_restFrames; // in a row it's barely moved
+    glm::vec3 m_restPosition; // where collision had left it, as of the last integration
+    glm::vec3 m_restPush; // how far it had been pushed since
 
 
 };
@@ -4,30 +4,37 @@
 #include "glm/gtc/matrix_transform.hpp"
 
 #include "Scene/Scene.hpp"
+#include "Util/Pool.hpp"
 #include "Util/Util.hpp"
 
 
 
 SpatialComponent::SpatialComponent(GameObject & gameObject, SpatialComponent * parent) :
     Component(gameObject),
-    m_relPosition(), m_prevRelPosition(m_relPosition),
-    m_isRelPositionChange(false),
-    m_relScale(1.0f), m_prevRelScale(m_relScale),
-    m_isRelScaleChange(false),
-    m_relOrientation(), m_prevRelOrientation(m_relOrientation),
-    m_relOrientMatrix(), m_prevRelOrientMatrix(m_relOrientMatrix),
-    m_isRelOrientationChange(false),
-    m_parent(parent),
-    m_children(),
-    m_dt(std::numeric_limits<float>::infinity()),
-
-    m_modelMat(), m_prevModelMat(),
-    m_normalMat(), m_prevNormalMat(),
+    m_relPosition(),
+    m_relScale(1.0f),
+    m_relOrientMatrix(),
+    m_isRelPositionChange(false), m_isRelScaleChange(false), m_isRelOrientationChange(false),
     m_modelMatValid(false), m_prevModelMatValid(false),
     m_normalMatValid(false), m_prevNormalMatValid(false),
-    m_modelMatChanged(false), m_normalMatChanged(false)
+    m_modelMatChanged(false), m_normalMatChanged(false),
+    m_isDirty(false),
+    m_movedIndex(-1),
+    m_parent(parent),
+    m_modelMat(),
+    m_normalMat(),
+    m_basis(),
+    m_relOrientation(),
+    m_cold(allocateCold())
 {
-    if (m_parent) m_parent->m_children.push_back(this);
+    m_cold->prevRelPosition = m_relPosition;
+    m_cold->prevRelScale = m_relScale;
+    m_cold->prevRelOrientation = m_relOrientation;
+    m_cold->prevRelOrientMatrix = m_relOrientMatrix;
+    if (m_parent) {
+        m_parent->m_cold->children.push_back(this);
+        SpatialSystem::addToHierarchy(*this);
+    }
 }
 
 SpatialComponent::SpatialComponent(GameObject & gameObject, const glm::vec3 & relativePosition, SpatialComponent * parent) :
@@ -56,67 +63,98 @@ SpatialComponent::SpatialComponent(GameObject & gameObject, const glm::vec3 & re
 
 SpatialComponent::SpatialComponent(SpatialComponent && o) :
     Component(std::move(o)),
-    m_relPosition(o.m_relPosition), m_prevRelPosition(o.m_prevRelPosition),
-    m_isRelPositionChange(o.m_isRelPositionChange),
-    m_relScale(o.m_relScale), m_prevRelScale(o.m_prevRelScale),
-    m_isRelScaleChange(o.m_isRelScaleChange),
-    m_relOrientation(o.m_relOrientation), m_prevRelOrientation(o.m_prevRelOrientation),
-    m_relOrientMatrix(o.m_relOrientMatrix), m_prevRelOrientMatrix(o.m_prevRelOrientMatrix),
-    m_isRelOrientationChange(o.m_isRelOrientationChange),
-    m_parent(o.m_parent),
-    m_children(std::move(o.m_children)),
-    m_dt(o.m_dt),
-
-    m_modelMat(o.m_modelMat), m_prevModelMat(o.m_prevModelMat),
-    m_normalMat(o.m_normalMat), m_prevNormalMat(o.m_prevNormalMat),
+    m_relPosition(o.m_relPosition),
+    m_relScale(o.m_relScale),
+    m_relOrientMatrix(o.m_relOrientMatrix),
+    m_isRelPositionChange(o.m_isRelPositionChange), m_isRelScaleChange(o.m_isRelScaleChange), m_isRelOrientationChange(o.m_isRelOrientationChange),
     m_modelMatValid(o.m_modelMatValid), m_prevModelMatValid(o.m_prevModelMatValid),
     m_normalMatValid(o.m_normalMatValid), m_prevNormalMatValid(o.m_prevNormalMatValid),
-    m_modelMatChanged(o.m_modelMatChanged), m_normalMatChanged(o.m_normalMatChanged)
+    m_modelMatChanged(o.m_modelMatChanged), m_normalMatChanged(o.m_normalMatChanged),
+    m_isDirty(false),
+    m_movedIndex(-1),
+    m_parent(o.m_parent),
+    m_modelMat(o.m_modelMat),
+    m_normalMat(o.m_normalMat),
+    m_basis(o.m_basis),
+    m_relOrientation(o.m_relOrientation),
+    m_cold(o.m_cold)
 {
+    if (o.m_movedIndex >= 0 || o.m_isDirty) {
+        bool dirty(o.m_isDirty);
+        SpatialSystem::unmarkChanged(o);
+        SpatialSystem::markChanged(*this, dirty);
+    }
+    o.m_cold = nullptr;
     o.m_parent = nullptr;
 
     if (m_parent) {
+        // takes o's place in the hierarchy first, so orphaning o doesn't drop it
+        SpatialSystem::replaceInHierarchy(o, *this);
         m_parent->orphan(o);
-        m_parent->m_children.push_back(this);
+        m_parent->m_cold->children.push_back(this);
     }
-    for (SpatialComponent * child : m_children) {
+    for (SpatialComponent * child : m_cold->children) {
         child->m_parent = this;
     }
 }
 
-void SpatialComponent::update(float dt) {
-    m_dt = dt;
+SpatialComponent::~SpatialComponent() {
+    if (m_movedIndex >= 0 || m_isDirty) {
+        SpatialSystem::unmarkChanged(*this);
+    }
+    if (m_parent) {
+        SpatialSystem::removeFromHierarchy(*this);
+    }
+    if (m_cold) {
+        releaseCold(*m_cold);
+    }
+}
 
+void SpatialComponent::update(float dt) {
     if (m_isRelPositionChange) {
-        m_prevRelPosition = m_relPosition;
+        m_cold->prevRelPosition = m_relPosition;
         m_isRelPositionChange = false;
     }
     if (m_isRelScaleChange) {
-        m_prevRelScale = m_relScale;
+        m_cold->prevRelScale = m_relScale;
         m_isRelScaleChange = false;
     }
     if (m_isRelOrientationChange) {
-        m_prevRelOrientation = m_relOrientation;
-        m_prevRelOrientMatrix = m_relOrientMatrix;
+        m_cold->prevRelOrientation = m_relOrientation;
+        m_cold->prevRelOrientMatrix = m_relOrientMatrix;
         m_isRelOrientationChange = false;
     }
     if (m_modelMatChanged) {
-        if (m_modelMatValid) m_prevModelMat = m_modelMat;
+        if (m_modelMatValid) m_cold->prevModelMat = m_modelMat;
         m_prevModelMatValid = m_modelMatValid;
         m_modelMatChanged = false;
     }
     if (m_normalMatChanged) {
-        if (m_normalMatValid) m_prevNormalMat = m_normalMat;
+        if (m_normalMatValid) m_cold->prevNormalMat = m_normalMat;
         m_prevNormalMatValid = m_normalMatValid;
         m_normalMatChanged = false;
     }
 }
 
+void SpatialComponent::settle() {
+    m_cold->prevRelPosition = m_relPosition;
+    m_cold->prevRelScale = m_relScale;
+    m_cold->prevRelOrientation = m_relOrientation;
+    m_cold->prevRelOrientMatrix = m_relOrientMatrix;
+    m_isRelPositionChange = m_isRelScaleChange = m_isRelOrientationChange = false;
+
+    m_cold->prevModelMat = modelMatrix();
+    m_cold->prevNormalMat = normalMatrix();
+    m_prevModelMatValid = m_prevNormalMatValid = true;
+    m_modelMatChanged = m_normalMatChanged = false;
+}
+
 void SpatialComponent::orphan(SpatialComponent & child) {
-    for (auto it(m_children.begin()); it != m_children.end(); ++it) {
+    for (auto it(m_cold->children.begin()); it != m_cold->children.end(); ++it) {
         if (*it == &child) {
-            m_children.erase(it);
+            m_cold->children.erase(it);
             child.m_parent = nullptr;
+            SpatialSystem::removeFromHierarchy(child);
             return;
         }
     }
@@ -126,7 +164,7 @@ void SpatialComponent::setRelativePosition(const glm::vec3 & position, bool sile
     if (position != m_relPosition) {
         m_isRelPositionChange = true;
         m_relPosition = position;
-        m_prevRelPosition = m_relPosition;
+        m_cold->prevRelPosition = m_relPosition;
         propagate(false, true, silently);
     }
 }
@@ -143,7 +181,7 @@ void SpatialComponent::setRelativeScale(const glm::vec3 & scale, bool silently)
     if (scale != m_relScale) {
         m_isRelScaleChange = true;
         m_relScale = scale;
-        m_prevRelScale = m_relScale;
+        m_cold->prevRelScale = m_relScale;
         propagate(false, false, silently);
     }
 }
@@ -160,9 +198,9 @@ void SpatialComponent::setRelativeOrientation(const glm::quat & relativeOrientat
     if (relativeOrientation != m_relOrientation) {
         m_isRelOrientationChange = true;
         m_relOrientation = relativeOrientation;
-        m_prevRelOrientation = m_relOrientation;
+        m_cold->prevRelOrientation = m_relOrientation;
         m_relOrientMatrix = glm::toMat3(relativeOrientation);
-        m_prevRelOrientMatrix = m_relOrientMatrix;
+        m_cold->prevRelOrientMatrix = m_relOrientMatrix;
         propagate(false, false, silently);
     }
 }
@@ -171,9 +209,9 @@ void SpatialComponent::setRelativeOrientation(const glm::mat3 & relativeOrientat
     if (relativeOrientation != m_relOrientMatrix) {
         m_isRelOrientationChange = true;
         m_relOrientMatrix = relativeOrientation;
-        m_prevRelOrientMatrix = m_relOrientMatrix;
+        m_cold->prevRelOrientMatrix = m_relOrientMatrix;
         m_relOrientation = glm::toQuat(relativeOrientation);
-        m_prevRelOrientation = m_relOrientation;
+        m_cold->prevRelOrientation = m_relOrientation;
         propagate(false, false, silently);
     }
 }
@@ -214,15 +252,15 @@ void SpatialComponent::lookInDir(const glm::vec3 & dir, const glm::vec3 & up) {
 }
 
 glm::vec3 SpatialComponent::relativePosition(float interpP) const {
-    return m_isRelPositionChange ? glm::mix(m_prevRelPosition, m_relPosition, interpP) : m_relPosition;
+    return m_isRelPositionChange ? glm::mix(m_cold->prevRelPosition, m_relPosition, interpP) : m_relPosition;
 }
 
 glm::vec3 SpatialComponent::position() const {
-    return m_parent ? m_parent->modelMatrix() * glm::vec4(m_relPosition, 1.0f) : m_relPosition;
+    return m_parent ? glm::vec3(modelMatrix()[3]) : m_relPosition;
 }
 
 glm::vec3 SpatialComponent::prevPosition() const {
-    return m_parent ? m_parent->prevModelMatrix() * glm::vec4(m_prevRelPosition, 1.0f) : m_prevRelPosition;
+    return m_parent ? m_parent->prevModelMatrix() * glm::vec4(m_cold->prevRelPosition, 1.0f) : m_cold->prevRelPosition;
 }
 
 glm::vec3 SpatialComponent::position(float interpP) const {
@@ -230,7 +268,7 @@ glm::vec3 SpatialComponent::position(float interpP) const {
 }
 
 glm::vec3 SpatialComponent::relativeScale(float interpP) const {
-    return m_isRelScaleChange ? glm::mix(m_prevRelScale, m_relScale, interpP) : m_relScale;
+    return m_isRelScaleChange ? glm::mix(m_cold->prevRelScale, m_relScale, interpP) : m_relScale;
 }
 
 glm::vec3 SpatialComponent::scale() const {
@@ -254,10 +292,10 @@ glm::vec3 SpatialComponent::prevScale() const {
             glm::length(glm::vec3(mat[0])),
             glm::length(glm::vec3(mat[1])),
             glm::length(glm::vec3(mat[2]))
-        ) * m_prevRelScale;
+        ) * m_cold->prevRelScale;
     }
     else {
-        return m_prevRelScale;
+        return m_cold->prevRelScale;
     }
 }
 
@@ -278,15 +316,21 @@ glm::vec3 SpatialComponent::relativeW(float interpP) const {
 }
 
 glm::vec3 SpatialComponent::u() const {
-    return m_parent ? glm::normalize(glm::vec3(m_parent->modelMatrix() * glm::vec4(relativeU(), 0.0f))) : relativeU(); 
+    if (!m_parent) return relativeU();
+    if (!m_modelMatValid) updateModelMatrix();
+    return m_basis[0];
 }
 
 glm::vec3 SpatialComponent::v() const {
-    return m_parent ? glm::normalize(glm::vec3(m_parent->modelMatrix() * glm::vec4(relativeV(), 0.0f))) : relativeV(); 
+    if (!m_parent) return relativeV();
+    if (!m_modelMatValid) updateModelMatrix();
+    return m_basis[1];
 }
 
 glm::vec3 SpatialComponent::w() const {
-    return m_parent ? glm::normalize(glm::vec3(m_parent->modelMatrix() * glm::vec4(relativeW(), 0.0f))) : relativeW(); 
+    if (!m_parent) return relativeW();
+    if (!m_modelMatValid) updateModelMatrix();
+    return m_basis[2];
 }
 
 glm::vec3 SpatialComponent::prevU() const {
@@ -316,7 +360,7 @@ glm::vec3 SpatialComponent::w(float interpP) const {
 glm::quat SpatialComponent::relativeOrientation(float interpP) const {
     // TODO: make sure lerp is good enough for our purposes. Could use
     // slerp, but it uses 4 trig functions, which is hella expensive
-    return m_isRelOrientationChange ? glm::lerp(m_prevRelOrientation, m_relOrientation, interpP) : m_relOrientation;
+    return m_isRelOrientationChange ? glm::lerp(m_cold->prevRelOrientation, m_relOrientation, interpP) : m_relOrientation;
 }
 
 glm::mat3 SpatialComponent::relativeOrientMatrix(float interpP) const {
@@ -328,7 +372,7 @@ glm::quat SpatialComponent::orientation() const {
 }
 
 glm::quat SpatialComponent::prevOrientation() const {
-    return m_parent ? m_parent->prevOrientation() * m_prevRelOrientation : m_prevRelOrientation;
+    return m_parent ? m_parent->prevOrientation() * m_cold->prevRelOrientation : m_cold->prevRelOrientation;
 }
 
 glm::quat SpatialComponent::orientation(float interpP) const {
@@ -340,7 +384,7 @@ glm::mat3 SpatialComponent::orientMatrix() const {
 }
 
 glm::mat3 SpatialComponent::prevOrientMatrix() const {
-    return m_parent ? m_parent->prevOrientMatrix() * m_prevRelOrientMatrix : m_prevRelOrientMatrix;
+    return m_parent ? m_parent->prevOrientMatrix() * m_cold->prevRelOrientMatrix : m_cold->prevRelOrientMatrix;
 }
 
 glm::mat3 SpatialComponent::orientMatrix(float interpP) const {
@@ -348,25 +392,34 @@ glm::mat3 SpatialComponent::orientMatrix(float interpP) const {
 }
 
 const glm::mat4 & SpatialComponent::modelMatrix() const {
-    if (m_modelMatValid) {
-        return m_modelMat;
+    if (!m_modelMatValid) {
+        updateModelMatrix();
     }
+    return m_modelMat;
+}
 
+void SpatialComponent::updateModelMatrix() const {
     m_modelMat = Util::compositeTransform(m_relScale, m_relOrientMatrix, m_relPosition);
-    if (m_parent) m_modelMat = m_parent->modelMatrix() * m_modelMat;
+    if (m_parent) {
+        m_modelMat = m_parent->modelMatrix() * m_modelMat;
+        // the parent's transform of each relative axis, scaled by the
+        // relative scale, which normalizing takes back out
+        m_basis[0] = glm::normalize(glm::vec3(m_modelMat[0]));
+        m_basis[1] = glm::normalize(glm::vec3(m_modelMat[1]));
+        m_basis[2] = glm::normalize(glm::vec3(m_modelMat[2]));
+    }
     m_modelMatValid = true;
-    return m_modelMat;
 }
     
 const glm::mat4 & SpatialComponent::prevModelMatrix() const {
     if (m_prevModelMatValid) {
-        return m_prevModelMat;
+        return m_cold->prevModelMat;
     }
 
-    m_prevModelMat = Util::compositeTransform(m_prevRelScale, m_prevRelOrientMatrix, m_prevRelPosition);
-    if (m_parent) m_prevModelMat = m_parent->prevModelMatrix() * m_prevModelMat;
+    m_cold->prevModelMat = Util::compositeTransform(m_cold->prevRelScale, m_cold->prevRelOrientMatrix, m_cold->prevRelPosition);
+    if (m_parent) m_cold->prevModelMat = m_parent->prevModelMatrix() * m_cold->prevModelMat;
     m_prevModelMatValid = true;
-    return m_prevModelMat;
+    return m_cold->prevModelMat;
 }
 
 glm::mat4 SpatialComponent::modelMatrix(float interpP) const {
@@ -393,14 +446,14 @@ const glm::mat3 & SpatialComponent::normalMatrix() const {
 
 const glm::mat3 & SpatialComponent::prevNormalMatrix() const {
     if (m_prevNormalMatValid) {
-        return m_prevNormalMat;
+        return m_cold->prevNormalMat;
     }
 
     // this is valid and waaaaaaaay faster than inverting the model matrix
-    m_prevNormalMat = m_prevRelOrientMatrix * glm::mat3(glm::scale(glm::mat4(), 1.0f / m_prevRelScale));
-    if (m_parent) m_prevNormalMat = m_parent->prevNormalMatrix() * m_prevNormalMat;
+    m_cold->prevNormalMat = m_cold->prevRelOrientMatrix * glm::mat3(glm::scale(glm::mat4(), 1.0f / m_cold->prevRelScale));
+    if (m_parent) m_cold->prevNormalMat = m_parent->prevNormalMatrix() * m_cold->prevNormalMat;
     m_prevNormalMatValid = true;
-    return m_prevNormalMat;
+    return m_cold->prevNormalMat;
 }
 
 glm::mat3 SpatialComponent::normalMatrix(float interpP) const {
@@ -415,16 +468,40 @@ glm::mat3 SpatialComponent::normalMatrix(float interpP) const {
 }
 
 glm::vec3 SpatialComponent::effectiveVelocity() const {
-    return (position() - prevPosition()) / m_dt;
+    return (position() - prevPosition()) / SpatialSystem::s_dt;
+}
+
+SpatialComponent::Cold * SpatialComponent::allocateCold() {
+    std::lock_guard<std::mutex> lock(coldMutex());
+    return new (coldPool().allocate()) Cold();
+}
+
+void SpatialComponent::releaseCold(Cold & cold) {
+    std::lock_guard<std::mutex> lock(coldMutex());
+    coldPool().destroy(cold);
+}
+
+Pool<SpatialComponent::Cold> & SpatialComponent::coldPool() {
+    // never freed, so it outlives the spatials in the scene's pools, which are
+    // only destroyed at exit
+    static Pool<Cold> & s_pool(*new Pool<Cold>());
+    return s_pool;
+}
+
+std::mutex & SpatialComponent::coldMutex() {
+    static std::mutex & s_mutex(*new std::mutex());
+    return s_mutex;
 }
 
 void SpatialComponent::propagate(bool modelMatValid, bool normalMatValid, bool silently) const {
+    assert(!isStatic()); // has to be made dynamic before it can change
     m_modelMatValid = m_modelMatValid && modelMatValid;
     m_normalMatValid = m_normalMatValid && normalMatValid;
     m_modelMatChanged = m_modelMatChanged || !modelMatValid;
     m_normalMatChanged = m_normalMatChanged || !normalMatValid;
-    if (!silently) Scene::sendMessage<SpatialChangeMessage>(&gameObject(), *this);
-    for (SpatialComponent * child : m_children) {
+    // recorded once per frame, to be rolled over, and published unless silent
+    if (m_movedIndex < 0 || (!silently && !m_isDirty)) SpatialSystem::markChanged(*this, !silently);
+    for (SpatialComponent * child : m_cold->children) {
         child->propagate(false, false, silently);
     }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 
 
+#include <mutex>
+
 #include "glm/glm.hpp"
 
 #include "Component/Component.hpp"
@@ -13,6 +15,7 @@
 
 
 class SpatialSystem;
+template <typename T, size_t t_chunkSize> class Pool;
 
 
 
@@ -39,6 +42,14 @@ class SpatialComponent : public Component {
 
     SpatialComponent(SpatialComponent && other);
 
+    virtual ~SpatialComponent();
+
+    protected:
+
+    // Catches the previous transform up to the current one and computes the
+    // matrices, which then stay valid
+    virtual void settle() override;
+
     public:
 
     virtual void update(float dt) override;
@@ -79,7 +90,7 @@ class SpatialComponent : public Component {
 
     // Get the relative position
     const glm::vec3 & relativePosition() const { return m_relPosition; }
-    const glm::vec3 & prevRelativePosition() const { return m_prevRelPosition; }
+    const glm::vec3 & prevRelativePosition() const { return m_cold->prevRelPosition; }
     glm::vec3 relativePosition(float interpP) const;
 
     // Get the absolute position
@@ -89,7 +100,7 @@ class SpatialComponent : public Component {
 
     // Get the relative scale
     const glm::vec3 & relativeScale() const { return m_relScale; }
-    const glm::vec3 & prevRelativeScale() const { return m_prevRelScale; }
+    const glm::vec3 & prevRelativeScale() const { return m_cold->prevRelScale; }
     glm::vec3 relativeScale(float interpP) const;
 
     // Get the absolute scale
@@ -101,9 +112,9 @@ class SpatialComponent : public Component {
     const glm::vec3 & relativeU() const { return m_relOrientMatrix[0]; }
     const glm::vec3 & relativeV() const { return m_relOrientMatrix[1]; }
     const glm::vec3 & relativeW() const { return m_relOrientMatrix[2]; }
-    const glm::vec3 & prevRelativeU() const { return m_prevRelOrientMatrix[0]; }
-    const glm::vec3 & prevRelativeV() const { return m_prevRelOrientMatrix[1]; }
-    const glm::vec3 & prevRelativeW() const { return m_prevRelOrientMatrix[2]; }
+    const glm::vec3 & prevRelativeU() const { return m_cold->prevRelOrientMatrix[0]; }
+    const glm::vec3 & prevRelativeV() const { return m_cold->prevRelOrientMatrix[1]; }
+    const glm::vec3 & prevRelativeW() const { return m_cold->prevRelOrientMatrix[2]; }
     glm::vec3 relativeU(float interpP) const;
     glm::vec3 relativeV(float interpP) const;
     glm::vec3 relativeW(float interpP) const;
@@ -121,11 +132,11 @@ class SpatialComponent : public Component {
 
     // Get the relative orientation
     const glm::quat & relativeOrientation() const { return m_relOrientation; }
-    const glm::quat & prevRelativeOrientation() const { return m_prevRelOrientation; }
+    const glm::quat & prevRelativeOrientation() const { return m_cold->prevRelOrientation; }
     glm::quat relativeOrientation(float interpP) const;
 
     const glm::mat3 & relativeOrientMatrix() const { return m_relOrientMatrix; }
-    const glm::mat3 & prevRelativeOrientMatrix() const { return m_prevRelOrientMatrix; };
+    const glm::mat3 & prevRelativeOrientMatrix() const { return m_cold->prevRelOrientMatrix; };
     glm::mat3 relativeOrientMatrix(float interpP) const;
 
     // Get the absolute orientation
@@ -158,23 +169,47 @@ class SpatialComponent : public Component {
 
     void propagate(bool modelMatValid, bool normalMatValid, bool silently) const;
 
-    private:
+    // Recomputes the model matrix, and the absolute uvw along with it
+    void updateModelMatrix() const;
 
-    glm::vec3 m_relPosition, m_prevRelPosition;
-    bool m_isRelPositionChange;
-    glm::vec3 m_relScale, m_prevRelScale;
-    bool m_isRelScaleChange;
-    glm::quat m_relOrientation, m_prevRelOrientation;
-    glm::mat3 m_relOrientMatrix, m_prevRelOrientMatrix;
-    bool m_isRelOrientationChange;
-    SpatialComponent * m_parent;
-    Vector<SpatialComponent *> m_children;
-    float m_dt;
+    private:
 
-    mutable glm::mat4 m_modelMat, m_prevModelMat;
-    mutable glm::mat3 m_normalMat, m_prevNormalMat;
+    struct Cold {
+        glm::vec3 prevRelPosition;
+        glm::vec3 prevRelScale;
+        glm::quat prevRelOrientation;
+        glm::mat3 prevRelOrientMatrix;
+        glm::mat4 prevModelMat;
+        glm::mat3 prevNormalMat;
+        Vector<SpatialComponent *> children;
+    };
+
+    // Spatials are created from jobs, so these lock
+    static Cold * allocateCold();
+    static void releaseCold(Cold & cold);
+    static Pool<Cold, 128> & coldPool();
+    static std::mutex & coldMutex();
+
+    // Hot, touched whenever the spatial moves or its matrices are read
+
+    glm::vec3 m_relPosition;
+    glm::vec3 m_relScale;
+    glm::mat3 m_relOrientMatrix;
+    bool m_isRelPositionChange, m_isRelScaleChange, m_isRelOrientationChange;
     mutable bool m_modelMatValid, m_prevModelMatValid;
     mutable bool m_normalMatValid, m_prevNormalMatValid;
     mutable bool m_modelMatChanged, m_normalMatChanged;
+    mutable bool m_isDirty; // in SpatialSystem's list of changes yet to be published
+    mutable int m_movedIndex; // in SpatialSystem's list of spatials to roll over, or -1
+    SpatialComponent * m_parent;
+    mutable glm::mat4 m_modelMat;
+    mutable glm::mat3 m_normalMat;
+    mutable glm::mat3 m_basis; // absolute uvw, kept with the model matrix when there's a parent
+    glm::quat m_relOrientation;
+
+    // Cold, only read for interpolation, or when the spatial is rolled over or
+    // reparented
+
+    Cold * m_cold;
 
 };
\ No newline at end of file
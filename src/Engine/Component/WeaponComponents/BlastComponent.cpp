@@ -22,8 +22,7 @@ BlastComponent::BlastComponent(GameObject & gameObject, float damage) :
 void BlastComponent::init() {
     if (!(m_bounder = dynamic_cast<SphereBounderComponent *>(gameObject().getComponentByType<BounderComponent>()))) assert(false);
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         const GameObject & go(msg.bounder2.gameObject());
         const SpatialComponent * spat(go.getSpatial());
         HealthComponent * health(go.getComponentByType<HealthComponent>());
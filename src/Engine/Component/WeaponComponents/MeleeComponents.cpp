@@ -41,8 +41,7 @@ SprayComponent::SprayComponent(GameObject & gameObject, const SpatialComponent *
 void SprayComponent::init() {
     MeleeComponent::init();
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         if (&msg.bounder1 == m_bounder) {
             // Damage things that spray hits
             HealthComponent * health(msg.bounder2.gameObject().getComponentByType<HealthComponent>());
@@ -35,8 +35,7 @@ BulletComponent::BulletComponent(GameObject & gameObject, const GameObject * hos
 void BulletComponent::init() {
     ProjectileComponent::init();
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         if (&msg.bounder1 == m_bounder) {
             // If collided with something with health that's not the host, detonate
             HealthComponent * health;
@@ -91,8 +90,7 @@ void GrenadeComponent::init() {
 
     if (!(m_ground = gameObject().getComponentByType<GroundComponent>())) assert(false);
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         if (&msg.bounder1 == m_bounder) {
             // If collided with something with health that's not the host, detonate
             if (msg.bounder2.gameObject().getComponentByType<HealthComponent>() && &msg.bounder2.gameObject() != m_host) {
@@ -102,8 +100,7 @@ void GrenadeComponent::init() {
     });
     Scene::addReceiver<CollisionMessage>(&gameObject(), collisionCallback);
 
-    auto bounceCallback([&] (const Message & msg_) {
-        const BounceMessage & msg(static_cast<const BounceMessage &>(msg_));
+    auto bounceCallback([&](const BounceMessage & msg) {
         if (++m_nBounces > k_maxBounces) {
             m_shouldDetonate = true;
         }
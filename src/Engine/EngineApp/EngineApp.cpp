@@ -6,6 +6,7 @@
 #include "IO/Window.hpp"
 #include "Scene/Scene.hpp"
 #include "Util/Util.hpp"
+#include "Util/JobSystem.hpp"
 #include "Loader/Loader.hpp"
 
 String EngineApp::RESOURCE_DIR = "../resources/";
@@ -24,6 +25,7 @@ int EngineApp::init() {
         return 1;
     }
 
+    JobSystem::init();
     Scene::init();
     Loader::init(verbose, RESOURCE_DIR);
 
@@ -55,5 +57,6 @@ void EngineApp::run() {
 }
 
 void EngineApp::terminate() {
+    JobSystem::shutDown();
     Window::shutDown();
 }
@@ -1,42 +1,91 @@
 #include "GameObject.hpp"
 
+#include <cstring>
+
 #include "Component/Component.hpp"
 #include "Component/SpatialComponents/SpatialComponent.hpp"
 
 GameObject::GameObject() :
-    m_allComponents(),
-    m_compsByCompT(),
-    m_spatialComponent(nullptr)
+    m_typeMask(0),
+    m_nComponents(0),
+    m_componentCapacity(k_nInlineComponents),
+    m_components(m_inlineComponents),
+    m_componentTypeIDs(m_inlineComponentTypeIDs),
+    m_inlineComponents(),
+    m_inlineComponentTypeIDs(),
+    m_spatialComponent(nullptr),
+    m_receivers(),
+    m_sceneIndex(-1),
+    m_isStatic(false)
 {}
 
-void GameObject::addComponent(Component & component, std::type_index typeI) {
-    m_allComponents.push_back(&component);
-    m_compsByCompT[typeI].push_back(&component);
-    if (typeI == std::type_index(typeid(SpatialComponent)) && !m_spatialComponent) {
-        m_spatialComponent = dynamic_cast<SpatialComponent *>(&component);
+GameObject::~GameObject() {
+    if (m_components != m_inlineComponents) {
+        deallocate(m_components);
     }
 }
 
-void GameObject::removeComponent(Component & component, std::type_index typeI) {
-    // remove from allComponents
-    for (auto it(m_allComponents.begin()); it != m_allComponents.end(); ++it) {
-        if (*it == &component) {
-            m_allComponents.erase(it);
-            break;
+void GameObject::addComponent(Component & component, int typeID) {
+    assert(typeID < k_maxComponentTypes);
+
+    // grow out of inline storage, type IDs are stored right after the pointers
+    if (m_nComponents == m_componentCapacity) {
+        int capacity(m_componentCapacity * 2);
+        Component ** components(static_cast<Component **>(allocate(capacity * (sizeof(Component *) + sizeof(uint8_t)))));
+        uint8_t * typeIDs(reinterpret_cast<uint8_t *>(components + capacity));
+        std::memcpy(components, m_components, m_nComponents * sizeof(Component *));
+        std::memcpy(typeIDs, m_componentTypeIDs, m_nComponents * sizeof(uint8_t));
+        if (m_components != m_inlineComponents) {
+            deallocate(m_components);
         }
+        m_components = components;
+        m_componentTypeIDs = typeIDs;
+        m_componentCapacity = capacity;
+    }
+
+    // insert after any others of the same type
+    int i(firstOfType(typeID));
+    while (i < m_nComponents && m_componentTypeIDs[i] == typeID) {
+        ++i;
+    }
+    std::memmove(m_components + i + 1, m_components + i, (m_nComponents - i) * sizeof(Component *));
+    std::memmove(m_componentTypeIDs + i + 1, m_componentTypeIDs + i, (m_nComponents - i) * sizeof(uint8_t));
+    m_components[i] = &component;
+    m_componentTypeIDs[i] = uint8_t(typeID);
+    ++m_nComponents;
+    m_typeMask |= uint64_t(1) << typeID;
+
+    if (typeID == TypeIDs<Component>::get<SpatialComponent>() && !m_spatialComponent) {
+        m_spatialComponent = dynamic_cast<SpatialComponent *>(&component);
+    }
+}
+
+void GameObject::removeComponent(Component & component, int typeID) {
+    if (!hasType(typeID)) {
+        return;
     }
-    // remove from compsByCompT in reverse order
-    auto compsIt(m_compsByCompT.find(typeI));
-    if (compsIt != m_compsByCompT.end()) {
-        auto & comps(compsIt->second);
-        for (int i(int(comps.size()) - 1); i >= 0; --i) {
-            if (comps[i] == &component) {
-                comps.erase(comps.begin() + i);
-                break;
+    int first(firstOfType(typeID)), n(0);
+    for (int i(first); i < m_nComponents && m_componentTypeIDs[i] == typeID; ++i, ++n) {
+        if (m_components[i] == &component) {
+            std::memmove(m_components + i, m_components + i + 1, (m_nComponents - i - 1) * sizeof(Component *));
+            std::memmove(m_componentTypeIDs + i, m_componentTypeIDs + i + 1, (m_nComponents - i - 1) * sizeof(uint8_t));
+            --m_nComponents;
+            // that was the last of its type
+            if (n == 0 && (i == m_nComponents || m_componentTypeIDs[i] != typeID)) {
+                m_typeMask &= ~(uint64_t(1) << typeID);
             }
+            break;
         }
     }
     if (m_spatialComponent == &component) {
         m_spatialComponent = nullptr;
     }
 }
+
+int GameObject::firstOfType(int typeID) const {
+    int i(0);
+    while (i < m_nComponents && m_componentTypeIDs[i] < typeID) {
+        ++i;
+    }
+    return i;
+}
@@ -5,17 +5,50 @@
 #define _GAME_OBJECT_HPP_
 
 #include <type_traits>
-#include <typeindex>
 #include <functional>
+#include <cstdint>
 
 #include "glm/glm.hpp"
 #include "Util/Memory.hpp"
+#include "Util/TypeID.hpp"
+#include "Receiver.hpp"
 
 class Scene;
 class Component;
 class SpatialComponent;
 struct Message;
 
+
+
+// A contiguous run of a game object's components
+template <typename CompT>
+class ComponentRange {
+
+    public:
+
+    ComponentRange(Component * const * begin, Component * const * end) :
+        m_begin(reinterpret_cast<CompT * const *>(begin)),
+        m_end(reinterpret_cast<CompT * const *>(end))
+    {}
+
+    CompT * const * begin() const { return m_begin; }
+    CompT * const * end() const { return m_end; }
+
+    size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+
+    CompT * operator[](size_t i) const { return m_begin[i]; }
+    CompT * front() const { return *m_begin; }
+
+    private:
+
+    CompT * const * m_begin;
+    CompT * const * m_end;
+
+};
+
+
+
 class GameObject {
 
     friend Scene;
@@ -27,7 +60,9 @@ class GameObject {
     public:
 
     GameObject(const GameObject & other) = delete; // doesn't make sense to copy a GameObject
-    GameObject(GameObject && other) = default;
+    GameObject(GameObject && other) = delete; // lives in scene's pool and never moves
+
+    ~GameObject();
 
     GameObject & operator=(const GameObject & other) = delete;
 
@@ -37,16 +72,16 @@ class GameObject {
 
     // add a component
     template <typename CompT> void addComponent(CompT & component);
-    void addComponent(Component & component, std::type_index typeI);
+    void addComponent(Component & component, int typeID);
 
-    void removeComponent(Component & component, std::type_index typeI);
+    void removeComponent(Component & component, int typeID);
 
     public:
 
-    // get all components;
-    const Vector<Component *> & getComponents() const { return m_allComponents; }
-    // get all components of a specific type
-    template <typename CompT> const Vector<CompT *> & getComponentsByType() const;
+    // get all components, ordered by type
+    ComponentRange<Component> getComponents() const { return ComponentRange<Component>(m_components, m_components + m_nComponents); }
+    // get all components of a specific type, in the order they were added
+    template <typename CompT> ComponentRange<CompT> getComponentsByType() const;
 
     // get first component of a specific type
     template <typename CompT> CompT * getComponentByType() const;
@@ -54,12 +89,38 @@ class GameObject {
     // get the spatial component
     SpatialComponent * getSpatial() const { return m_spatialComponent; }
 
+    // static objects never move or change, see Scene::setStatic
+    bool isStatic() const { return m_isStatic; }
+
+    private:
+
+    bool hasType(int typeID) const { return (m_typeMask >> typeID) & 1; }
+
+    // index of the first component of the type, or where it would go
+    int firstOfType(int typeID) const;
+
+    public:
+
+    // component type IDs must be below this to fit in the type mask
+    static constexpr int k_maxComponentTypes = 64;
+    // most objects have no more components than this, so they need no allocation
+    static constexpr int k_nInlineComponents = 12;
+
     private:
 
-    Vector<Component *> m_allComponents;
-    UnorderedMap<std::type_index, Vector<Component *>> m_compsByCompT;
+    uint64_t m_typeMask; // bit per component type present
+    int m_nComponents;
+    int m_componentCapacity;
+    // sorted by type ID, then by order added. Point to the inline arrays until
+    // the object outgrows them
+    Component ** m_components;
+    uint8_t * m_componentTypeIDs;
+    Component * m_inlineComponents[k_nInlineComponents];
+    uint8_t m_inlineComponentTypeIDs[k_nInlineComponents];
     SpatialComponent * m_spatialComponent;
-    UnorderedMap<std::type_index, Vector<std::function<void (const Message &)>>> m_receivers;
+    Vector<Vector<Receiver>> m_receivers; // indexed by message type ID
+    int m_sceneIndex; // position in scene's game object list, or -1 if not in the scene
+    bool m_isStatic;
 
 };
 
@@ -74,21 +135,23 @@ void GameObject::addComponent(CompT & component) {
     static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
     static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
 
-    addComponent(component, std::type_index(typeid(CompT)));
+    addComponent(component, TypeIDs<Component>::get<CompT>());
 }
 
 template <typename CompT>
-const Vector<CompT *> & GameObject::getComponentsByType() const {
+ComponentRange<CompT> GameObject::getComponentsByType() const {
     static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
     static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
 
-    static const Vector<CompT *> s_emptyList;
-
-    auto it(m_compsByCompT.find(std::type_index(typeid(CompT))));
-    if (it != m_compsByCompT.end()) {
-        return reinterpret_cast<const Vector<CompT *> &>(it->second);
+    int typeID(TypeIDs<Component>::get<CompT>());
+    if (!hasType(typeID)) {
+        return ComponentRange<CompT>(m_components, m_components);
+    }
+    int first(firstOfType(typeID)), last(first + 1);
+    while (last < m_nComponents && m_componentTypeIDs[last] == typeID) {
+        ++last;
     }
-    return s_emptyList;
+    return ComponentRange<CompT>(m_components + first, m_components + last);
 }
 
 template <typename CompT>
@@ -96,11 +159,11 @@ CompT * GameObject::getComponentByType() const {
     static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
     static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
 
-    auto it(m_compsByCompT.find(std::type_index(typeid(CompT))));
-    if (it != m_compsByCompT.end() && it->second.size()) {
-        return static_cast<CompT *>(it->second.front());
+    int typeID(TypeIDs<Component>::get<CompT>());
+    if (!hasType(typeID)) {
+        return nullptr;
     }
-    return nullptr;
+    return static_cast<CompT *>(m_components[firstOfType(typeID)]);
 }
 
 
@@ -6,6 +6,8 @@
 
 
 #include "glm/glm.hpp"
+
+#include "Util/Memory.hpp"
 // Don't add includes. If possible, forward declard. This file shouldn't contain
 // any functionality, and it will be included all over the place.
 
@@ -24,29 +26,33 @@
 // game object and message type. This is for efficient inter-component
 // communication.
 //
-// The scene keeps a list of messages, and what type they were, until it's time
-// to relay the messages. This happens before and after every system update.
-// The system will only relay messages to any receivers of the corresponding
-// type. A receiver is a std::function<void (const Message &)> . To add a
+// The scene keeps a queue of messages for each message type, held by value,
+// until it's time to relay the messages. This happens before and after every
+// system update. The system will only relay messages to any receivers of the
+// corresponding type. Messages of the same type are relayed in the order they
+// were sent, but there is no ordering between different types. A receiver is
+// any callable taking a const reference to the message type. To add a
 // receiver, do...
 //
-//     Scene::addReceiver<MessageType>([nullptr | gameobject], receiver);
+//     ReceiverHandle h(Scene::addReceiver<MessageType>([nullptr | gameobject], receiver));
 //
 // Here, if gameobject is null, the receiver will receive all messages of the
 // specified type. If gameobject is not null, the receiver will only receive
 // messages of the specified type that have been sent to that object. This is
 // how you do efficient inter-component communication.
 //
-// For receiver, can pass either a function pointer or a lambda. Note, you can
-// technically bind a method to a std::function, but it's ugly. For adding
-// receivers from objects that can reference that object, I reccommend using a
-// lambda, like so...
+// Receivers are stored inline rather than in a std::function, so they must be
+// small and trivially copyable. In practice this means a function pointer or a
+// lambda capturing by reference, like so...
 //    
-//    auto receiver = [&](const Message & msg_) {
-//        const MessageIWantType & msg(static_cast<const MessageIWantType &>(msg_));
+//    auto receiver = [&](const MessageIWantType & msg) {
 //        ...
 //    };
-//    Scene::addReceiver<MessageIWantType>(receiver);
+//    Scene::addReceiver<MessageIWantType>(nullptr, receiver);
+//
+// A receiver can be taken out with Scene::removeReceiver(h). Receivers added
+// during a component's init are removed automatically along with that
+// component.
 //
 // There is also the idea of a Tag, which is simply a way for messages of
 // different types but sharing the same data to be accessed. For an example of
@@ -77,12 +83,21 @@ struct ObjectInitMessage : public Message {
 
 
 
-// a spatiality was changed in some way
+// a spatiality was changed in some way. Sent at most once per spatial per
+// messaging pass, no matter how many times it changed
 struct SpatialChangeMessage : public Message {
     const SpatialComponent & spatial;
     SpatialChangeMessage(const SpatialComponent & spatial) : spatial(spatial) {}
 };
 
+// all the spatials that changed since the last messaging pass, for systems
+// that only care whether something moved. The list is only valid while the
+// message is being relayed
+struct SpatialChangesMessage : public Message {
+    const Vector<const SpatialComponent *> & spatials;
+    SpatialChangesMessage(const Vector<const SpatialComponent *> & spatials) : spatials(spatials) {}
+};
+
 
 
 // a camera was rotated
@@ -157,15 +172,16 @@ struct ScrollMessage : public Message {
 // component has put through the init queue and added to the scene
 struct ComponentAddedMessage : public Message {
     Component & comp;
-    std::type_index typeI;
-    ComponentAddedMessage(Component & comp, std::type_index typeI) : comp(comp), typeI(typeI) {}
+    int typeID; // component type ID the component was registered as
+    ComponentAddedMessage(Component & comp, int typeID) : comp(comp), typeID(typeID) {}
 };
 
 // component has been added to kill queue and will be removed from the scene
+// the component is not destroyed until after this message has been relayed
 struct ComponentRemovedMessage : public Message {
-    UniquePtr<Component> comp;
-    std::type_index typeI;
-    ComponentRemovedMessage(UniquePtr<Component> && comp, std::type_index typeI) : comp(std::move(comp)), typeI(typeI) {}
+    Component & comp;
+    int typeID; // component type ID the component was registered as
+    ComponentRemovedMessage(Component & comp, int typeID) : comp(comp), typeID(typeID) {}
 };
 
 
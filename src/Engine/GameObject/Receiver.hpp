@@ -0,0 +1,114 @@
+/* Message receivers
+ * Small, non-allocating stand in for std::function<void (const Message &)> */
+#pragma once
+#ifndef _RECEIVER_HPP_
+#define _RECEIVER_HPP_
+
+
+
+#include <type_traits>
+#include <cstdint>
+
+#include "Util/Pool.hpp"
+
+class Scene;
+class GameObject;
+class Component;
+struct Message;
+
+
+
+// The callable is copied into a small inline buffer and called through a plain
+// function pointer that knows the message type, so adding a receiver never
+// allocates and relaying a message never needs to cast it
+class Receiver {
+
+    friend Scene;
+
+    public:
+
+    // a pointer or two worth of captures, e.g. [&] capturing this
+    static constexpr size_t k_maxSize = 2 * sizeof(void *);
+
+    Receiver() :
+        m_invoke(nullptr),
+        m_storage(),
+        m_owner(nullptr),
+        m_id(0)
+    {}
+
+    // F is called with a const MsgT &
+    template <typename MsgT, typename F> static Receiver make(const F & f, const Component * owner, uint32_t id);
+
+    void operator()(const Message & msg) const { m_invoke(&m_storage, msg); }
+
+    // false if the receiver has been removed
+    explicit operator bool() const { return m_invoke; }
+
+    private:
+
+    template <typename MsgT, typename F> static void invoke(const void * f, const Message & msg);
+
+    private:
+
+    void (*m_invoke)(const void *, const Message &);
+    typename std::aligned_storage<k_maxSize, alignof(void *)>::type m_storage;
+    const Component * m_owner; // removed along with this component, if not null
+    uint32_t m_id;
+
+};
+
+
+
+// Returned when adding a receiver, and used to remove it again. Safe to use
+// after the game object it was added to has been destroyed
+class ReceiverHandle {
+
+    friend Scene;
+
+    public:
+
+    ReceiverHandle() :
+        m_gameObject(),
+        m_global(false),
+        m_msgTypeID(-1),
+        m_id(0)
+    {}
+
+    private:
+
+    Handle<GameObject> m_gameObject;
+    bool m_global; // receives messages sent to any object
+    int m_msgTypeID;
+    uint32_t m_id;
+
+};
+
+
+
+// TEMPLATE IMPLEMENTATION /////////////////////////////////////////////////////
+
+
+
+template <typename MsgT, typename F>
+Receiver Receiver::make(const F & f, const Component * owner, uint32_t id) {
+    static_assert(sizeof(F) <= k_maxSize, "Receiver captures too much, capture this and use members instead");
+    static_assert(alignof(F) <= alignof(void *), "Receiver is over aligned");
+    static_assert(std::is_trivially_copyable<F>::value, "Receiver must be trivially copyable, capture by reference");
+
+    Receiver receiver;
+    new (&receiver.m_storage) F(f);
+    receiver.m_invoke = &invoke<MsgT, F>;
+    receiver.m_owner = owner;
+    receiver.m_id = id;
+    return receiver;
+}
+
+template <typename MsgT, typename F>
+void Receiver::invoke(const void * f, const Message & msg) {
+    (*static_cast<const F *>(f))(static_cast<const MsgT &>(msg));
+}
+
+
+
+#endif
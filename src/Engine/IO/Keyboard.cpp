@@ -1,6 +1,6 @@
 #include "Keyboard.hpp"
 
-#include "GLFW/glfw3.h"
+#include "OpenGL.hpp"
 
 int Keyboard::keyStatus[NUM_KEYS] = { GLFW_RELEASE };
 
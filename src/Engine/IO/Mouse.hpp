@@ -4,7 +4,7 @@
 #ifndef _MOUSE_HPP_
 #define _MOUSE_HPP_
 
-#include <GLFW/glfw3.h>
+#include "OpenGL.hpp"
 
 class Mouse {
     public:
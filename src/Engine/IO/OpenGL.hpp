@@ -0,0 +1,68 @@
+/* OpenGL and GLFW
+ * Includes GLEW and GLFW. A headless build has neither, so instead only the
+ * types and constants used outside of rendering are declared */
+#pragma once
+#ifndef _OPENGL_HPP_
+#define _OPENGL_HPP_
+
+
+
+#ifndef HEADLESS_MODE
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#else
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef float GLfloat;
+typedef unsigned char GLboolean;
+
+#define GL_FALSE 0
+#define GL_TRUE 1
+#define GL_REPEAT 0x2901
+#define GL_CLAMP_TO_EDGE 0x812F
+
+struct GLFWwindow;
+
+#define GLFW_RELEASE 0
+#define GLFW_PRESS 1
+#define GLFW_REPEAT 2
+
+#define GLFW_MOD_SHIFT 0x0001
+#define GLFW_MOD_CONTROL 0x0002
+#define GLFW_MOD_ALT 0x0004
+
+#define GLFW_MOUSE_BUTTON_1 0
+#define GLFW_MOUSE_BUTTON_2 1
+#define GLFW_MOUSE_BUTTON_LAST 7
+
+#define GLFW_KEY_SPACE 32
+#define GLFW_KEY_1 49
+#define GLFW_KEY_2 50
+#define GLFW_KEY_3 51
+#define GLFW_KEY_4 52
+#define GLFW_KEY_A 65
+#define GLFW_KEY_D 68
+#define GLFW_KEY_G 71
+#define GLFW_KEY_M 77
+#define GLFW_KEY_S 83
+#define GLFW_KEY_W 87
+#define GLFW_KEY_GRAVE_ACCENT 96
+#define GLFW_KEY_ESCAPE 256
+#define GLFW_KEY_ENTER 257
+#define GLFW_KEY_TAB 258
+#define GLFW_KEY_BACKSPACE 259
+#define GLFW_KEY_DELETE 261
+#define GLFW_KEY_F11 300
+#define GLFW_KEY_LEFT_SHIFT 340
+
+#endif
+
+
+
+#endif
@@ -19,6 +19,7 @@ bool Window::s_vSyncEnabled = true;
 bool Window::s_cursorEnabled = true;
 bool Window::s_imGuiEnabled = false;
 
+#ifndef HEADLESS_MODE
 void Window::errorCallback(int error, const char *desc) {
     std::cerr << "Error " << error << ": " << desc << std::endl;
 }
@@ -138,8 +139,13 @@ void Window::framebufferSizeCallback(GLFWwindow * window, int width, int height)
 void Window::cursorEnterCallback(GLFWwindow * window, int entered) {
     Mouse::reset();
 }
+#endif
 
 int Window::init(const String & name) {
+#ifdef HEADLESS_MODE
+    /* No window, but cameras still need a frame size */
+    s_frameSize = s_windowedSize;
+#else
     /* Set error callback */
     glfwSetErrorCallback(errorCallback);
 
@@ -195,26 +201,34 @@ int Window::init(const String & name) {
     glfwSwapInterval(s_vSyncEnabled);
 
     glfwGetFramebufferSize(s_window, &s_frameSize.x, &s_frameSize.y);
+#endif
 
     return 0;
 }
 
 void Window::setTitle(const char *name) {
+#ifndef HEADLESS_MODE
     glfwSetWindowTitle(s_window, name);
+#endif
 }
 
 void Window::setSize(const glm::ivec2 & size) {
+#ifndef HEADLESS_MODE
     if (!s_fullscreen) {
         glfwSetWindowSize(s_window, s_windowedSize.x, s_windowedSize.y);
     }
+#endif
 }
 
 void Window::toggleVSync() {
     s_vSyncEnabled = !s_vSyncEnabled;
+#ifndef HEADLESS_MODE
     glfwSwapInterval(s_vSyncEnabled);
+#endif
 }
 
 void Window::update(float dt) {
+#ifndef HEADLESS_MODE
     /* Don't update display if window is minimized */
     if (glfwGetWindowAttrib(s_window, GLFW_ICONIFIED)) {
         return;
@@ -237,16 +251,23 @@ void Window::update(float dt) {
 #endif
     
     glfwSwapBuffers(s_window);
+#endif
 }
 
 int Window::shouldClose() { 
+#ifdef HEADLESS_MODE
+    return 0;
+#else
     return glfwWindowShouldClose(s_window);
+#endif
 }
 
 void Window::shutDown() {
+#ifndef HEADLESS_MODE
     /* Clean up GLFW */
     glfwDestroyWindow(s_window);
     glfwTerminate();
+#endif
 }
 
 void Window::toggleImGui() {
@@ -258,7 +279,9 @@ void Window::toggleImGui() {
 
 void Window::setCursorEnabled(bool enabled) {
     s_cursorEnabled = enabled;
+#ifndef HEADLESS_MODE
     glfwSetInputMode(s_window, GLFW_CURSOR, s_cursorEnabled ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_DISABLED);
+#endif
     if (enabled) {
         Mouse::reset();
         Keyboard::reset();
@@ -1,12 +1,11 @@
 /* GLFW Handler
- * Maintains GLFW window, mouse, and keyboard*/
+ * Maintains GLFW window, mouse, and keyboard
+ * A headless build has no window, so this only keeps the frame size */
 #pragma once
 #ifndef _GLFW_HANDLER_HPP_
 #define _GLFW_HANDLER_HPP_
 
-#define GLEW_STATIC
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
+#include "OpenGL.hpp"
 
 #include "glm/glm.hpp"
 
@@ -5,6 +5,7 @@
 #include "System/RenderSystem.hpp"
 #include "System/CollisionSystem.hpp"
 #include "Scene/Scene.hpp"
+#include "Loader.hpp"
 #include "Component/SpatialComponents/SpatialComponent.hpp"
 #include "Model/ModelTexture.hpp"
 #include "Component/CollisionComponents/BounderComponent.hpp"
@@ -155,6 +156,9 @@ int FileReader::loadLevel(const char & filePath) {
         return 1;
     }
 
+    //Level objects get their own memory, which is released all at once when the level is unloaded
+    Scene::beginLevel(int(document.MemberCount()));
+
     //For each object in the json document
     for (auto& m : document.GetObject()) {
         const rapidjson::Value& jsonObject = document[m.name.GetString()];
@@ -187,7 +191,12 @@ int FileReader::loadLevel(const char & filePath) {
         if(filePath.compare("") != 0) {
             DiffuseRenderComponent & renderComp(FileReader::addRenderComponent(gameObject, spatialComp, jsonTransform, filePath));
         }
+
+        //Level geometry never moves, so is left out of per frame updates
+        Scene::setStatic(gameObject, true);
     }
 
+    Scene::endLevel();
+
     return 0;
 }
\ No newline at end of file
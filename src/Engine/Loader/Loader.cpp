@@ -8,6 +8,8 @@
 #include <iostream>
 
 #include "Util/Memory.hpp"
+#include "Util/Profiler.hpp"
+#include "Util/Util.hpp"
 #include "FileReader.hpp"
 
 bool Loader::verbose = false;
@@ -19,6 +21,8 @@ void Loader::init(bool verbose, const String & res) {
 }
 
 Mesh* Loader::getMesh(const String & name) {
+    PROFILE_ZONE("Loader::getMesh");
+    MemoryScope memoryScope(MemoryCategory::Loader);
     Mesh* mesh = Library::getMesh(name);
     if (mesh) {
         return mesh;
@@ -93,6 +97,7 @@ uint8_t* Loader::loadTextureData(const String & fileName, const bool flip, int *
 
 
 Texture* Loader::getTexture(const String & name, GLenum mode, bool flip) {
+    MemoryScope memoryScope(MemoryCategory::Loader);
     Texture *texture = Library::getTexture(name);
     if (texture) {
         return texture;
@@ -102,9 +107,13 @@ Texture* Loader::getTexture(const String & name, GLenum mode, bool flip) {
     uint8_t *data = loadTextureData(RESOURCE_DIR + name, flip, &texture->width, &texture->height, &texture->components);
     if(data) {
         loadTexture(texture, data, mode);
+#ifdef HEADLESS_MODE
+        Library::addTexture(name, texture);
+#else
         if (texture->textureId) {
             Library::addTexture(name, texture);
         }
+#endif
         stbi_image_free(data);
     }
     return texture;
@@ -115,7 +124,14 @@ Texture* Loader::getTexture(const String & name) {
 }
 
 int Loader::loadLevel(const String & name) {
-    return FileReader::loadLevel(*name.c_str());
+    PROFILE_ZONE("Loader::loadLevel");
+    MemoryScope memoryScope(MemoryCategory::Loader);
+    Util::Stopwatch watch;
+    int rc(FileReader::loadLevel(*name.c_str()));
+    if (verbose && !rc) {
+        std::cout << "Loaded level (" << watch.total() * 1.0e3 << " ms): " << name << std::endl;
+    }
+    return rc;
 }
 
 /* Provided function to resize a mesh so all vertex positions are [0, 1.f] */
@@ -177,6 +193,7 @@ void Loader::resize(Mesh::MeshBuffers & buffers) {
 }
 
 void Loader::loadTexture(Texture *texture, uint8_t *data, GLenum mode) {
+#ifndef HEADLESS_MODE
     /* Set active texture unit 0 */
     glActiveTexture(GL_TEXTURE0);
 
@@ -208,9 +225,11 @@ void Loader::loadTexture(Texture *texture, uint8_t *data, GLenum mode) {
 
     /* Error check */
     assert(glGetError() == GL_NO_ERROR);
+#endif
 }
 
 void Loader::loadMesh(Mesh & mesh) {
+#ifndef HEADLESS_MODE
     /* Initialize VAO */
     glGenVertexArrays(1, &mesh.vaoId);
     glBindVertexArray(mesh.vaoId);
@@ -247,4 +266,5 @@ void Loader::loadMesh(Mesh & mesh) {
 
     /* Error check */
     assert(glGetError() == GL_NO_ERROR);
+#endif
 }
\ No newline at end of file
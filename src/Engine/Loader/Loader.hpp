@@ -1,12 +1,11 @@
 /* Loader class
  * Responsible for loading in external files
- * Responsible for loading CPU memory onto GPU */
+ * Responsible for loading CPU memory onto GPU, except in a headless build */
 #pragma once
 #ifndef _LOADER_HPP_
 #define _LOADER_HPP_
 
-#define GLEW_STATIC
-#include <GL/glew.h>
+#include "IO/OpenGL.hpp"
 #include <cstdint>
 
 #include "Model/Mesh.hpp"
@@ -4,8 +4,7 @@
 #ifndef _TEXTURE_HPP_
 #define _TEXTURE_HPP_
 
-#define GLEW_STATIC
-#include <GL/glew.h>
+#include "IO/OpenGL.hpp"
 
 #include <cstdint>
 
@@ -1,5 +1,8 @@
 #include "Scene.hpp"
 
+#include <algorithm>
+
+#include "Scheduler.hpp"
 #include "System/GameSystem.hpp"
 #include "System/SpatialSystem.hpp"
 #include "System/PathfindingSystem.hpp"
@@ -10,42 +13,47 @@
 #include "System/SoundSystem.hpp"
 #include "System/ParticleSystem.hpp"
 #include "Util/Util.hpp"
+#include "Util/Profiler.hpp"
 #include "Component/SpatialComponents/SpatialComponent.hpp"
 #include "IO/Window.hpp"
 #include "Component/ImGuiComponents/ImGuiComponent.hpp"
 
 
 
-Vector<UniquePtr<GameObject>> Scene::s_gameObjects;
-UnorderedMap<std::type_index, UniquePtr<Vector<UniquePtr<Component>>>> Scene::s_components;
+Pool<GameObject> Scene::s_gameObjectPool;
+Vector<GameObject *> Scene::s_gameObjects;
+Vector<UniquePtr<detail::ComponentPoolBase>> Scene::s_componentPools;
+
+Vector<GameObject *> Scene::s_gameObjectInitQueue;
+Vector<Handle<GameObject>> Scene::s_gameObjectKillQueue;
+Vector<std::pair<int, Component *>> Scene::s_componentInitQueue;
+Vector<std::pair<int, Handle<Component>>> Scene::s_componentKillQueue;
+Vector<Component *> Scene::s_componentReleaseQueue;
+Vector<std::pair<Handle<GameObject>, bool>> Scene::s_staticQueue;
+Vector<size_t> Scene::s_staticCounts;
+
+Vector<UniquePtr<detail::ViewBase>> Scene::s_views;
+Vector<Vector<detail::ViewBase *>> Scene::s_viewsByType;
+std::mutex Scene::s_viewsMutex;
 
-Vector<UniquePtr<GameObject>> Scene::s_gameObjectInitQueue;
-Vector<GameObject *> Scene::s_gameObjectKillQueue;
-Vector<std::pair<std::type_index, UniquePtr<Component>>> Scene::s_componentInitQueue;
-Vector<std::pair<std::type_index, Component *>> Scene::s_componentKillQueue;
+thread_local detail::SceneLane * Scene::s_lane(nullptr);
+std::mutex Scene::s_laneMutex;
 
-Vector<std::tuple<const GameObject *, std::type_index, UniquePtr<Message>>> Scene::s_messages;
-UnorderedMap<std::type_index, Vector<std::function<void (const Message &)>>> Scene::s_receivers;
+thread_local bool Scene::s_loadingLevel(false);
+int Scene::s_levelCapacity(0);
+Vector<Handle<GameObject>> Scene::s_levelGameObjects;
+bool Scene::s_levelUnloaded(false);
+
+Vector<UniquePtr<detail::MessageQueueBase>> Scene::s_messageQueues;
+Vector<Vector<Receiver>> Scene::s_receivers;
+uint32_t Scene::s_nextReceiverID(1);
+Component * Scene::s_initComponent(nullptr);
+bool Scene::s_deadReceivers(false);
+Vector<Handle<GameObject>> Scene::s_deadReceiverObjects;
 
 float Scene::totalDT;
 float Scene::initDT;
 float Scene::killDT;
-float Scene::gameDT;
-float Scene::gameMessagingDT;
-float Scene::spatialDT;
-float Scene::spatialMessagingDT;
-float Scene::pathfindingDT;
-float Scene::pathfindingMessagingDT;
-float Scene::collisionDT;
-float Scene::collisionMessagingDT;
-float Scene::postCollisionDT;
-float Scene::postCollisionMessagingDT;
-float Scene::particleDT;
-float Scene::particleMessagingDT;
-float Scene::renderDT;
-float Scene::renderMessagingDT;
-float Scene::soundDT;
-float Scene::soundMessagingDT;
 
 bool Scene::mapping;
 String Scene::mapFilename;
@@ -60,74 +68,94 @@ void Scene::init() {
     RenderSystem::init();
     SoundSystem::init();
     GameSystem::init();
+
+    // order matters, systems only run alongside those next to them
+    Scheduler::add<GameSystem>("Game", true);
+    Scheduler::add<PathfindingSystem>("Pathfinding");
+    Scheduler::add<MapExploreSystem>("Map Explore");
+    Scheduler::add<SpatialSystem>("Spatial"); // needs to happen right before collision
+    Scheduler::add<CollisionSystem>("Collision");
+    Scheduler::add<PostCollisionSystem>("Post Collision"); // needs to happen after collision, go figure
+    Scheduler::add<ParticleSystem>("Particle");
+    Scheduler::add<RenderSystem>("Render", true); // rendering should be last
+    Scheduler::add<SoundSystem>("Sound");
 }
 
 GameObject & Scene::createGameObject() {
-    s_gameObjectInitQueue.emplace_back(UniquePtr<GameObject>::make(GameObject()));
-    return *s_gameObjectInitQueue.back().get();
+    MemoryScope memoryScope(MemoryCategory::Scene);
+    GameObject * go(new (allocate(s_gameObjectPool)) GameObject());
+    if (s_loadingLevel) {
+        s_levelGameObjects.push_back(getHandle(*go));
+    }
+    (s_lane ? s_lane->gameObjectInitQueue : s_gameObjectInitQueue).push_back(go);
+    return *go;
 }
 
 void Scene::destroyGameObject(GameObject & gameObject) {
-    s_gameObjectKillQueue.push_back(&gameObject);
+    (s_lane ? s_lane->gameObjectKillQueue : s_gameObjectKillQueue).push_back(getHandle(gameObject));
 }
 
-void Scene::update(float dt) {
-    Util::Stopwatch watch;
-
-    doInitQueue();
-    relayMessages();
-    initDT = float(watch.lap());
-
-    // This is here and not in SpatialSystem because this needs to happen right at the start of the game loop
-    for (SpatialComponent * comp : getComponents<SpatialComponent>()) { comp->update(dt); }
-    spatialDT = float(watch.lap());
-
-    GameSystem::update(dt);
-    gameDT = float(watch.lap());
-    relayMessages();
-    gameMessagingDT = float(watch.lap());
+void Scene::beginLevel(int nObjects) {
+    assert(!s_loadingLevel && !s_levelUnloaded); // the last level must be gone first
+    s_loadingLevel = true;
+    s_levelCapacity = nObjects;
+}
 
-    PathfindingSystem::update(dt);
-    pathfindingDT = float(watch.lap());
-    relayMessages();
-    pathfindingMessagingDT = float(watch.lap());
+void Scene::endLevel() {
+    s_loadingLevel = false;
+}
 
-    MapExploreSystem::update(dt);
-    relayMessages();
+void Scene::setStatic(GameObject & gameObject, bool isStatic) {
+    (s_lane ? s_lane->staticQueue : s_staticQueue).emplace_back(getHandle(gameObject), isStatic);
+}
 
-    SpatialSystem::update(dt); // needs to happen right before collision
-    spatialDT += float(watch.lap());
-    relayMessages();
-    spatialMessagingDT = float(watch.lap());
+void Scene::unloadLevel() {
+    for (Handle<GameObject> & handle : s_levelGameObjects) {
+        if (GameObject * go = handle.get()) {
+            destroyGameObject(*go);
+        }
+    }
+    s_levelGameObjects.clear();
+    s_levelUnloaded = true;
+}
 
-    CollisionSystem::update(dt);
-    collisionDT = float(watch.lap());
-    relayMessages();
-    collisionMessagingDT = float(watch.lap());
+Handle<Component> Scene::getHandle(Component & component) {
+    assert(component.m_poolID >= 0); // component was not created by the scene
+    // another lane could be adding a pool or growing this one
+    std::unique_lock<std::mutex> lock(s_laneMutex, std::defer_lock);
+    if (s_lane) {
+        lock.lock();
+    }
+    return s_componentPools[component.m_poolID]->handle(component);
+}
 
-    PostCollisionSystem::update(dt); // needs to happen after collision, go figure
-    postCollisionDT = float(watch.lap());
-    relayMessages();
-    postCollisionMessagingDT = float(watch.lap());
+void Scene::update(float dt) {
+    Profiler::beginFrame();
+    PROFILE_ZONE("Frame");
+    Util::Stopwatch watch;
 
-    ParticleSystem::update(dt);
-    particleDT = float(watch.lap());
+    doInitQueue();
     relayMessages();
-    particleMessagingDT = float(watch.lap());
 
-    RenderSystem::update(dt); // rendering should be last
-    renderDT = float(watch.lap());
-    relayMessages();
-    renderMessagingDT = float(watch.lap());
+    // This is here and not in SpatialSystem because this needs to happen right at the start of the game loop
+    SpatialSystem::rollover(dt);
+    // Likewise, as systems can pick before the collision system updates
+    CollisionSystem::updateStatics();
+    initDT = float(watch.lap());
 
-    SoundSystem::update(dt);
-    soundDT = float(watch.lap());
-    relayMessages();
-    soundMessagingDT = float(watch.lap());
+    Scheduler::update(dt);
+    watch.lap();
 
     doKillQueue();
     relayMessages();
+    releaseComponents();
+    if (s_levelUnloaded) {
+        releaseLevel();
+    }
+    // anything allocated from the frame arenas is gone from here on
+    FrameArena::endFrame();
     killDT = float(watch.lap());
+    MemoryStats::endFrame();
 
     totalDT = float(watch.total());
 
@@ -139,14 +167,23 @@ void Scene::update(float dt) {
 }
 
 void Scene::doInitQueue() {
+    PROFILE_ZONE("Init queue");
+    MemoryScope memoryScope(MemoryCategory::Scene);
     initGameObjects();
     initComponents();
+    applyStatics();
 }
 
 void Scene::doKillQueue() {
+    PROFILE_ZONE("Kill queue");
+    MemoryScope memoryScope(MemoryCategory::Scene);
     // remove components from game objects
     for (auto & killC : s_componentKillQueue) {
-        killC.second->gameObject().removeComponent(*killC.second, killC.first);
+        Component * comp(killC.second.get());
+        if (comp && comp->m_gameObject) {
+            comp->gameObject().removeComponent(*comp, killC.first);
+            updateViews(comp->gameObject(), killC.first);
+        }
     }
 
     killGameObjects();
@@ -154,9 +191,10 @@ void Scene::doKillQueue() {
 }
 
 void Scene::initGameObjects() {
-    for (auto & o : s_gameObjectInitQueue) {
-        sendMessage<ObjectInitMessage>(o.get());
-        s_gameObjects.emplace_back(std::move(o));
+    for (GameObject * o : s_gameObjectInitQueue) {
+        sendMessage<ObjectInitMessage>(o);
+        o->m_sceneIndex = int(s_gameObjects.size());
+        s_gameObjects.push_back(o);
     }
     s_gameObjectInitQueue.clear();
 }
@@ -165,82 +203,107 @@ void Scene::initComponents() {
     // add components to objects
     for (int i(0); i < s_componentInitQueue.size(); ++i) {
         auto & initE(s_componentInitQueue[i]);
-        auto & comp(initE.second);
-        comp->gameObject().addComponent(*comp.get(), initE.first);
+        Component * comp(initE.second);
+        comp->gameObject().addComponent(*comp, initE.first);
     }
     // add components to scene, initialize them, and indicate to systems that they've been added
     for (int i(0); i < s_componentInitQueue.size(); ++i) {
         auto & initE(s_componentInitQueue[i]);
-        std::type_index typeI(initE.first);
-        auto & comp(initE.second);
-        auto it(s_components.find(typeI));
-        if (it == s_components.end()) {
-            s_components.emplace(typeI, UniquePtr<Vector<UniquePtr<Component>>>::make());
-            it = s_components.find(typeI);
-        }
-        it->second->emplace_back(std::move(comp));
-        Component & c(*it->second->back());
+        int typeID(initE.first);
+        Component & c(*initE.second);
+        auto & comps(componentList(typeID));
+        c.m_sceneIndex = int(comps.size());
+        comps.push_back(&c);
+        // batched updates go by concrete type, and need it to stand for a single registered type
+        detail::ComponentPoolBase & pool(*s_componentPools[c.m_poolID]);
+        assert(pool.typeID < 0 || pool.typeID == typeID);
+        pool.typeID = typeID;
+        c.m_isStatic = c.gameObject().m_isStatic;
+        addToConcreteList(c, typeID);
+        updateViews(c.gameObject(), typeID);
+        s_initComponent = &c;
         c.init();
-        sendMessage<ComponentAddedMessage>(&c.gameObject(), c, typeI);
+        s_initComponent = nullptr;
+        if (c.m_isStatic) {
+            c.settle();
+        }
+        sendMessage<ComponentAddedMessage>(&c.gameObject(), c, typeID);
     }
     s_componentInitQueue.clear();
 }
 
 void Scene::killGameObjects() {
-    for (auto killIt(s_gameObjectKillQueue.begin()); killIt != s_gameObjectKillQueue.end(); ++killIt) {
-        bool found(false);
-        // look in active game objects, in reverse order
-        for (int i(int(s_gameObjects.size()) - 1); i >= 0; --i) {
-            GameObject * go(s_gameObjects[i].get());
-            if (go == *killIt) {
-                // add game object's components to kill queue
-                for (auto compTIt(go->m_compsByCompT.begin()); compTIt != go->m_compsByCompT.end(); ++compTIt) {
-                    for (auto & comp : compTIt->second) {
-                        comp->m_gameObject = nullptr;
-                        s_componentKillQueue.emplace_back(compTIt->first, comp);
-                    }
+    for (auto & killH : s_gameObjectKillQueue) {
+        GameObject * go(killH.get());
+        if (!go) {
+            continue; // already destroyed
+        }
+        if (go->m_sceneIndex >= 0) {
+            for (auto & view : s_views) {
+                if ((go->m_typeMask & view->mask) == view->mask) {
+                    removeFromView(*view, *go);
                 }
-                s_gameObjects.erase(s_gameObjects.begin() + i);
-                found = true;
-                break;
             }
+            // add game object's components to kill queue
+            for (int i(0); i < go->m_nComponents; ++i) {
+                Component * comp(go->m_components[i]);
+                comp->m_gameObject = nullptr;
+                s_componentKillQueue.emplace_back(go->m_componentTypeIDs[i], getHandle(*comp));
+            }
+            // swap and pop
+            GameObject * last(s_gameObjects.back());
+            s_gameObjects[go->m_sceneIndex] = last;
+            last->m_sceneIndex = go->m_sceneIndex;
+            s_gameObjects.pop_back();
         }
-        if (!found) {
+        else {
             // look in game object initialization queue, in reverse order
             for (int i(int(s_gameObjectInitQueue.size()) - 1); i >= 0; --i) {
-                if (s_gameObjectInitQueue[i].get() == *killIt) {
+                if (s_gameObjectInitQueue[i] == go) {
                     s_gameObjectInitQueue.erase(s_gameObjectInitQueue.begin() + i);
                     break;
                 }
             }
         }
+        s_gameObjectPool.destroy(*go);
     }
     s_gameObjectKillQueue.clear();
 }
 
 void Scene::killComponents() {
     for (auto & killE : s_componentKillQueue) {
-        std::type_index typeI(killE.first);
-        Component * comp(killE.second);
-        bool found(false);
-        // look in active components, in reverse order
-        if (s_components.count(typeI)) {
-            auto & comps(*s_components.at(typeI));
-            for (int i(int(comps.size()) - 1); i >= 0; --i) {
-                if (comps[i].get() == comp) {
-                    auto it(comps.begin() + i);
-                    sendMessage<ComponentRemovedMessage>(comp->m_gameObject, std::move(*it), typeI);
-                    comps.erase(it);
-                    found = true;
-                    break;
+        int typeID(killE.first);
+        Component * comp(killE.second.get());
+        if (!comp) {
+            continue; // already destroyed
+        }
+        if (comp->m_sceneIndex >= 0) {
+            auto & comps(componentList(typeID));
+            sendMessage<ComponentRemovedMessage>(comp->m_gameObject, *comp, typeID);
+            // swap and pop
+            Component * last(comps.back());
+            comps[comp->m_sceneIndex] = last;
+            last->m_sceneIndex = comp->m_sceneIndex;
+            comps.pop_back();
+            comp->m_sceneIndex = -1;
+            removeFromConcreteList(*comp, typeID);
+            if (comp->m_hasReceivers) {
+                removeReceivers(s_receivers, *comp);
+                if (comp->m_gameObject) {
+                    removeReceivers(comp->m_gameObject->m_receivers, *comp);
+                    s_deadReceiverObjects.push_back(getHandle(*comp->m_gameObject));
                 }
+                s_deadReceivers = true;
             }
+            // not destroyed until the message has been relayed
+            s_componentReleaseQueue.push_back(comp);
         }
-        if (!found) {
+        else {
             // look in component initialization queue, in reverse order
             for (int i(int(s_componentInitQueue.size()) - 1); i >= 0; --i) {
-                if (s_componentInitQueue[i].second.get() == comp) {
+                if (s_componentInitQueue[i].second == comp) {
                     s_componentInitQueue.erase(s_componentInitQueue.begin() + i);
+                    releaseComponent(*comp);
                     break;
                 }
             }
@@ -249,35 +312,287 @@ void Scene::killComponents() {
     s_componentKillQueue.clear();
 }
 
+Vector<Component *> & Scene::componentList(int typeID) {
+    // function static so systems can bind to lists during static initialization
+    static Vector<UniquePtr<Vector<Component *>>> s_components;
+
+    if (typeID >= int(s_components.size())) {
+        s_components.resize(typeID + 1);
+    }
+    if (!s_components[typeID]) {
+        s_components[typeID] = UniquePtr<Vector<Component *>>::make();
+    }
+    return *s_components[typeID];
+}
+
+void Scene::applyStatics() {
+    for (auto & staticE : s_staticQueue) {
+        GameObject * go(staticE.first.get());
+        if (!go || go->m_isStatic == staticE.second) {
+            continue;
+        }
+        go->m_isStatic = staticE.second;
+        for (int i(0); i < go->m_nComponents; ++i) {
+            Component & comp(*go->m_components[i]);
+            if (comp.m_sceneIndex < 0) {
+                continue; // picks it up when initialized
+            }
+            removeFromConcreteList(comp, go->m_componentTypeIDs[i]);
+            comp.m_isStatic = go->m_isStatic;
+            addToConcreteList(comp, go->m_componentTypeIDs[i]);
+            if (comp.m_isStatic) {
+                comp.settle();
+            }
+        }
+    }
+    s_staticQueue.clear();
+}
+
+void Scene::addToConcreteList(Component & component, int typeID) {
+    auto & typeComps(concreteList(component.m_poolID, component.m_isStatic));
+    component.m_poolIndex = int(typeComps.size());
+    typeComps.push_back(&component);
+    if (component.m_isStatic) {
+        if (typeID >= int(s_staticCounts.size())) {
+            s_staticCounts.resize(typeID + 1, 0);
+        }
+        ++s_staticCounts[typeID];
+    }
+}
+
+void Scene::removeFromConcreteList(Component & component, int typeID) {
+    // swap and pop
+    auto & typeComps(concreteList(component.m_poolID, component.m_isStatic));
+    Component * last(typeComps.back());
+    typeComps[component.m_poolIndex] = last;
+    last->m_poolIndex = component.m_poolIndex;
+    typeComps.pop_back();
+    component.m_poolIndex = -1;
+    if (component.m_isStatic) {
+        --s_staticCounts[typeID];
+    }
+}
+
+Vector<Component *> & Scene::concreteList(int poolID, bool isStatic) {
+    // function static so systems can bind to lists during static initialization
+    static Vector<UniquePtr<Vector<Component *>>> s_components;
+    // batched updates bind to their lists the first time they run, which may
+    // be alongside other systems
+    static std::mutex s_mutex;
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    // static and dynamic lists of a type sit side by side
+    int i(poolID * 2 + int(isStatic));
+    if (i >= int(s_components.size())) {
+        s_components.resize(i + 1);
+    }
+    if (!s_components[i]) {
+        s_components[i] = UniquePtr<Vector<Component *>>::make();
+    }
+    return *s_components[i];
+}
+
+const detail::ViewBase & Scene::makeView(std::initializer_list<int> typeIDs) {
+    std::lock_guard<std::mutex> lock(s_viewsMutex);
+    MemoryScope memoryScope(MemoryCategory::Scene);
+    s_views.emplace_back(UniquePtr<detail::ViewBase>::make());
+    detail::ViewBase & view(*s_views.back());
+    view.mask = 0;
+    for (int typeID : typeIDs) {
+        assert(typeID < GameObject::k_maxComponentTypes);
+        view.mask |= uint64_t(1) << typeID;
+        view.typeIDs.push_back(typeID);
+        if (typeID >= int(s_viewsByType.size())) {
+            s_viewsByType.resize(typeID + 1);
+        }
+        s_viewsByType[typeID].push_back(&view);
+    }
+    for (GameObject * go : s_gameObjects) {
+        updateView(view, *go);
+    }
+    return view;
+}
+
+void Scene::updateView(detail::ViewBase & view, GameObject & gameObject) {
+    if ((gameObject.m_typeMask & view.mask) != view.mask) {
+        removeFromView(view, gameObject);
+        return;
+    }
+    int nTypes(int(view.typeIDs.size()));
+    auto it(view.indices.find(&gameObject));
+    int index;
+    if (it == view.indices.end()) {
+        index = int(view.gameObjects.size());
+        view.indices[&gameObject] = index;
+        view.gameObjects.push_back(&gameObject);
+        view.components.resize(view.components.size() + nTypes);
+    }
+    else {
+        index = it->second;
+    }
+    // the first of a type may have been the one removed
+    for (int i(0); i < nTypes; ++i) {
+        view.components[index * nTypes + i] = gameObject.m_components[gameObject.firstOfType(view.typeIDs[i])];
+    }
+}
+
+void Scene::removeFromView(detail::ViewBase & view, const GameObject & gameObject) {
+    auto it(view.indices.find(&gameObject));
+    if (it == view.indices.end()) {
+        return;
+    }
+    // swap and pop
+    int nTypes(int(view.typeIDs.size()));
+    int index(it->second), last(int(view.gameObjects.size()) - 1);
+    view.indices.erase(it);
+    if (index != last) {
+        view.gameObjects[index] = view.gameObjects[last];
+        view.indices[view.gameObjects[index]] = index;
+        std::copy(view.components.begin() + last * nTypes, view.components.begin() + (last + 1) * nTypes, view.components.begin() + index * nTypes);
+    }
+    view.gameObjects.pop_back();
+    view.components.resize(view.components.size() - nTypes);
+}
+
+void Scene::updateViews(GameObject & gameObject, int typeID) {
+    if (typeID >= int(s_viewsByType.size())) {
+        return;
+    }
+    for (detail::ViewBase * view : s_viewsByType[typeID]) {
+        updateView(*view, gameObject);
+    }
+}
+
+void Scene::mergeLane(detail::SceneLane & lane) {
+    MemoryScope memoryScope(MemoryCategory::Scene);
+    s_gameObjectInitQueue.insert(s_gameObjectInitQueue.end(), lane.gameObjectInitQueue.begin(), lane.gameObjectInitQueue.end());
+    s_gameObjectKillQueue.insert(s_gameObjectKillQueue.end(), lane.gameObjectKillQueue.begin(), lane.gameObjectKillQueue.end());
+    s_componentInitQueue.insert(s_componentInitQueue.end(), lane.componentInitQueue.begin(), lane.componentInitQueue.end());
+    s_componentKillQueue.insert(s_componentKillQueue.end(), lane.componentKillQueue.begin(), lane.componentKillQueue.end());
+    s_staticQueue.insert(s_staticQueue.end(), lane.staticQueue.begin(), lane.staticQueue.end());
+    lane.gameObjectInitQueue.clear();
+    lane.gameObjectKillQueue.clear();
+    lane.componentInitQueue.clear();
+    lane.componentKillQueue.clear();
+    lane.staticQueue.clear();
+    for (auto & queue : lane.messageQueues) {
+        if (queue) {
+            queue->merge();
+        }
+    }
+}
+
+void Scene::releaseComponent(Component & component) {
+    assert(component.m_poolID >= 0); // component was not created by the scene
+    s_componentPools[component.m_poolID]->release(component);
+}
+
+void Scene::releaseComponents() {
+    MemoryScope memoryScope(MemoryCategory::Scene);
+    for (Component * comp : s_componentReleaseQueue) {
+        releaseComponent(*comp);
+    }
+    s_componentReleaseQueue.clear();
+}
+
+void Scene::releaseLevel() {
+    s_gameObjectPool.releaseLevel();
+    for (auto & pool : s_componentPools) {
+        if (pool) {
+            pool->releaseLevel();
+        }
+    }
+    s_levelUnloaded = false;
+}
+
+void Scene::removeReceiver(const ReceiverHandle & handle) {
+    Vector<Vector<Receiver>> * receivers(nullptr);
+    if (handle.m_global) {
+        receivers = &s_receivers;
+        s_deadReceivers = true;
+    }
+    else if (GameObject * go = handle.m_gameObject.get()) {
+        receivers = &go->m_receivers;
+        s_deadReceiverObjects.push_back(handle.m_gameObject);
+    }
+    if (!receivers || handle.m_msgTypeID >= int(receivers->size())) {
+        return;
+    }
+    for (Receiver & receiver : (*receivers)[handle.m_msgTypeID]) {
+        if (receiver.m_id == handle.m_id) {
+            receiver.m_invoke = nullptr;
+            return;
+        }
+    }
+}
+
 void Scene::relayMessages() {
-    static Vector<std::tuple<const GameObject *, std::type_index, UniquePtr<Message>>> s_messagesBuffer;
-
-    while (s_messages.size()) {
-        // this keeps things from breaking if messages are sent from receivers
-        std::swap(s_messages, s_messagesBuffer);
-
-        for (auto & message : s_messagesBuffer) {
-            const GameObject * gameObject(std::get<0>(message));
-            std::type_index msgTypeI(std::get<1>(message));
-            auto & msg(std::get<2>(message));
-
-            // send object-level message
-            if (gameObject) {
-                auto receivers(gameObject->m_receivers.find(msgTypeI));
-                if (receivers != gameObject->m_receivers.end()) {
-                    for (auto & receiver : receivers->second) {
-                        receiver(*msg);
-                    }
-                }
+    PROFILE_ZONE("Relay messages");
+    MemoryScope memoryScope(MemoryCategory::Messages);
+    // messages of a type are relayed in the order they were sent. Keep going
+    // until receivers stop sending more
+    int nRelayed;
+    do {
+        nRelayed = SpatialSystem::publishChanges();
+        for (int i(0); i < int(s_messageQueues.size()); ++i) {
+            if (s_messageQueues[i]) {
+                nRelayed += s_messageQueues[i]->relay();
             }
-            // send scene-level message
-            auto receivers(s_receivers.find(msgTypeI));
-            if (receivers != s_receivers.end()) {
-                for (auto & receiver : receivers->second) {
-                    receiver(*msg);
-                }
+        }
+    } while (nRelayed);
+
+    compactReceivers();
+}
+
+void Scene::relayMessage(const GameObject * gameObject, int msgTypeID, const Message & msg) {
+    // send object-level message
+    if (gameObject) {
+        relayMessage(const_cast<GameObject *>(gameObject)->m_receivers, msgTypeID, msg);
+    }
+    // send scene-level message
+    relayMessage(s_receivers, msgTypeID, msg);
+}
+
+void Scene::relayMessage(Vector<Vector<Receiver>> & receivers, int msgTypeID, const Message & msg) {
+    if (msgTypeID >= int(receivers.size())) {
+        return;
+    }
+    // receivers may add more receivers, so index and copy rather than hold
+    // references into the list. Anything added now waits for the next message
+    int n(int(receivers[msgTypeID].size()));
+    for (int i(0); i < n; ++i) {
+        Receiver receiver(receivers[msgTypeID][i]);
+        if (receiver) {
+            receiver(msg);
+        }
+    }
+}
+
+void Scene::compactReceivers(Vector<Vector<Receiver>> & receivers) {
+    for (auto & list : receivers) {
+        list.erase(std::remove_if(list.begin(), list.end(), [](const Receiver & r) { return !r; }), list.end());
+    }
+}
+
+void Scene::compactReceivers() {
+    if (s_deadReceivers) {
+        compactReceivers(s_receivers);
+        s_deadReceivers = false;
+    }
+    for (auto & goH : s_deadReceiverObjects) {
+        if (GameObject * go = goH.get()) {
+            compactReceivers(go->m_receivers);
+        }
+    }
+    s_deadReceiverObjects.clear();
+}
+
+void Scene::removeReceivers(Vector<Vector<Receiver>> & receivers, const Component & component) {
+    for (auto & list : receivers) {
+        for (Receiver & receiver : list) {
+            if (receiver.m_owner == &component) {
+                receiver.m_invoke = nullptr;
             }
         }
-        s_messagesBuffer.clear();
     }
-}
\ No newline at end of file
+}
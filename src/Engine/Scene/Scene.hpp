@@ -6,19 +6,88 @@
 
 
 
-#include <typeinfo>
-#include <typeindex>
+#include <initializer_list>
+#include <mutex>
 
 #include "Util/Memory.hpp"
+#include "Util/Pool.hpp"
+#include "Util/TypeID.hpp"
+#include "View.hpp"
 #include "GameObject/GameObject.hpp"
 #include "GameObject/Message.hpp"
+#include "GameObject/Receiver.hpp"
 #include "Component/Component.hpp"
 
 
 
+namespace detail {
+
+// Type erased handle to the pool a component was allocated from
+struct ComponentPoolBase {
+    int typeID = -1; // type the pool's components are registered as
+    virtual ~ComponentPoolBase() = default;
+    virtual void release(Component & component) = 0;
+    virtual Handle<Component> handle(Component & component) const = 0;
+    virtual void releaseLevel() = 0;
+};
+
+template <typename CompT>
+struct ComponentPool : public ComponentPoolBase {
+    Pool<CompT> pool;
+    virtual void release(Component & component) override { pool.destroy(static_cast<CompT &>(component)); }
+    virtual Handle<Component> handle(Component & component) const override { return pool.handle(static_cast<CompT &>(component)); }
+    virtual void releaseLevel() override { pool.releaseLevel(); }
+};
+
+// Type erased handle to the queue of a message type
+struct MessageQueueBase {
+    virtual ~MessageQueueBase() = default;
+    // Relays the messages queued so far and returns how many there were
+    virtual int relay() = 0;
+    // Moves the messages queued so far onto the end of the scene's queue
+    virtual void merge() = 0;
+};
+
+// Messages are stored by value and double buffered, so that messages sent by
+// receivers wait for the next pass. Neither buffer gives up its memory, so
+// once warmed up sending a message does not allocate
+template <typename MsgT>
+struct MessageQueue : public MessageQueueBase {
+    struct Entry {
+        const GameObject * gameObject;
+        MsgT msg;
+        template <typename... Args> Entry(const GameObject * gameObject, Args &&... args) : gameObject(gameObject), msg(std::forward<Args>(args)...) {}
+    };
+    Vector<Entry> messages;
+    Vector<Entry> relaying;
+    virtual int relay() override;
+    virtual void merge() override;
+};
+
+// Updates the components in each concrete type's list, one type at a time
+template <typename... CompTs> struct ComponentBatch;
+
+// Holds everything a scheduled system sends to the scene while it runs
+// alongside others, until it can be handed over in a deterministic order
+struct SceneLane {
+    Vector<UniquePtr<MessageQueueBase>> messageQueues; // indexed by message type ID
+    Vector<GameObject *> gameObjectInitQueue;
+    Vector<Handle<GameObject>> gameObjectKillQueue;
+    Vector<std::pair<int, Component *>> componentInitQueue;
+    Vector<std::pair<int, Handle<Component>>> componentKillQueue;
+    Vector<std::pair<Handle<GameObject>, bool>> staticQueue;
+};
+
+}
+
+
+
 // static class
 class Scene {
 
+    template <typename MsgT> friend struct detail::MessageQueue;
+    friend class Scheduler;
+
   public:
 
     static void init();
@@ -28,6 +97,23 @@ class Scene {
     static GameObject & createGameObject();
 
     static void destroyGameObject(GameObject & gameObject);
+
+    // Game objects created on this thread between beginLevel and endLevel,
+    // along with their components, belong to the level. They are allocated
+    // from level regions set apart in each pool, sized for nObjects objects
+    static void beginLevel(int nObjects);
+    static void endLevel();
+    // Destroys every game object that belongs to the level. The level regions
+    // are rewound in one go at the end of the frame, and the next level
+    // should be loaded after that
+    static void unloadLevel();
+
+    // Static game objects are ones that never move or change, like level
+    // geometry. Their components are left out of updateComponents, and are
+    // settled once into their final state, so spatials have their matrices
+    // computed up front. A static object has to be made dynamic again before
+    // it can be changed. Takes effect once the object's components are added
+    static void setStatic(GameObject & gameObject, bool isStatic);
     
     // Creates a component of the given type and adds it to the game object
     template <typename CompT, typename... Args> static CompT & addComponent(GameObject & gameObject, Args &&... args);
@@ -45,15 +131,45 @@ class Scene {
 
     // Adds a receiver for a message type. If gameObject is null, the receiver
     // will pick up all messages of that type. If gameObject is not null, the
-    // receiver will pick up only messages sent to that object
-    template <typename MsgT> static void addReceiver(const GameObject * gameObject, const std::function<void (const Message &)> & receiver);
+    // receiver will pick up only messages sent to that object. The receiver is
+    // called with a const MsgT &. Receivers added while a component is being
+    // initialized are removed when that component is
+    template <typename MsgT, typename F> static ReceiverHandle addReceiver(const GameObject * gameObject, const F & receiver);
 
-    static const Vector<GameObject *> & getGameObjects() { return reinterpret_cast<const Vector<GameObject *> &>(s_gameObjects); }
+    // Stops the receiver from picking up any more messages. Fine to call from
+    // within a receiver, or if the receiver is already gone
+    static void removeReceiver(const ReceiverHandle & handle);
+
+    static const Vector<GameObject *> & getGameObjects() { return s_gameObjects; }
 
     template <typename CompT> static const Vector<CompT *> & getComponents();
 
+    // Only the components whose concrete type is CompT, leaving out static
+    // ones, in no particular order. A concrete type must always be registered
+    // as the same type
+    template <typename CompT> static const Vector<CompT *> & getComponentsOfType();
+
+    // Updates every component registered as BaseT, a concrete type at a time.
+    // Those of the listed types are updated in a tight loop with no virtual
+    // dispatch, and any others with a virtual call afterwards. With no types
+    // listed, BaseT is taken to be the only one
+    template <typename BaseT, typename... CompTs> static void updateComponents(float dt);
+
+    // Game objects that have at least one component of each of CompTs. The
+    // view is made on the first call, then kept up to date as components are
+    // added and removed, so iterating it needs no lookups
+    template <typename... CompTs> static View<CompTs...> view();
+
+    // Handles can be held on to past the life of the game object or component,
+    // and will be null once it has been destroyed
+    static Handle<GameObject> getHandle(GameObject & gameObject) { return s_gameObjectPool.handle(gameObject); }
+    static Handle<Component> getHandle(Component & component);
+
   private:
 
+    // Allocates from the pool, or its level region while loading a level
+    template <typename T> static void * allocate(Pool<T> & pool);
+
     /* Initialization / kill queues */
     static void doInitQueue();
     static void doKillQueue();
@@ -62,43 +178,98 @@ class Scene {
     static void initComponents();
     static void killGameObjects();
     static void killComponents();
+    // Moves the components of objects made static or dynamic between lists
+    static void applyStatics();
 
     static void relayMessages();
+    // Sends a single message to its receivers
+    static void relayMessage(const GameObject * gameObject, int msgTypeID, const Message & msg);
+    static void relayMessage(Vector<Vector<Receiver>> & receivers, int msgTypeID, const Message & msg);
+
+    // Removed receivers are only marked dead, and are cleared out here once no
+    // messages are being relayed
+    static void compactReceivers(Vector<Vector<Receiver>> & receivers);
+    static void compactReceivers();
+    // Removes the receivers added by the component
+    static void removeReceivers(Vector<Vector<Receiver>> & receivers, const Component & component);
+
+    template <typename MsgT> static detail::MessageQueue<MsgT> & messageQueue();
+    template <typename MsgT> static detail::MessageQueue<MsgT> & messageQueue(detail::SceneLane & lane);
+
+    /* Lanes */
+    // While set, this thread is running a system alongside others, so its
+    // changes to the scene go to the lane instead
+    static void setLane(detail::SceneLane * lane) { s_lane = lane; }
+    // Hands over everything in the lane, as if it had been done just now
+    static void mergeLane(detail::SceneLane & lane);
+
+    /* Component storage */
+    // List of active components registered as the given component type ID
+    static Vector<Component *> & componentList(int typeID);
+    // List of active components whose concrete type has the given type ID,
+    // either static or not
+    static Vector<Component *> & concreteList(int poolID, bool isStatic = false);
+    static void addToConcreteList(Component & component, int typeID);
+    static void removeFromConcreteList(Component & component, int typeID);
+    // Number of static components registered as the type ID
+    static size_t staticCount(int typeID) { return typeID < int(s_staticCounts.size()) ? s_staticCounts[typeID] : 0; }
+    // Components of each concrete type are stored contiguously in their own pool
+    template <typename CompT> static Pool<CompT> & componentPool();
+    // Destroys the component and returns its memory to its pool
+    static void releaseComponent(Component & component);
+    // Destroys components that were removed this frame, once all messages have been relayed
+    static void releaseComponents();
+
+    /* Views */
+    static const detail::ViewBase & makeView(std::initializer_list<int> typeIDs);
+    // Adds the game object to or removes it from the view, or refreshes its
+    // components, depending on what it has now
+    static void updateView(detail::ViewBase & view, GameObject & gameObject);
+    static void removeFromView(detail::ViewBase & view, const GameObject & gameObject);
+    // Once a component of the type has been added to or removed from the object
+    static void updateViews(GameObject & gameObject, int typeID);
+    // Rewinds every pool's level region, once the level's objects are destroyed
+    static void releaseLevel();
 
   private:
 
-    static Vector<UniquePtr<GameObject>> s_gameObjects;
-    static UnorderedMap<std::type_index, UniquePtr<Vector<UniquePtr<Component>>>> s_components;
-
-    static Vector<UniquePtr<GameObject>> s_gameObjectInitQueue;
-    static Vector<GameObject *> s_gameObjectKillQueue;
-    static Vector<std::pair<std::type_index, UniquePtr<Component>>> s_componentInitQueue;
-    static Vector<std::pair<std::type_index, Component *>> s_componentKillQueue;
-
-    static Vector<std::tuple<const GameObject *, std::type_index, UniquePtr<Message>>> s_messages;
-    static UnorderedMap<std::type_index, Vector<std::function<void (const Message &)>>> s_receivers;
+    static Pool<GameObject> s_gameObjectPool;
+    static Vector<GameObject *> s_gameObjects;
+    static Vector<UniquePtr<detail::ComponentPoolBase>> s_componentPools; // indexed by component type ID
+
+    static Vector<GameObject *> s_gameObjectInitQueue;
+    static Vector<Handle<GameObject>> s_gameObjectKillQueue;
+    static Vector<std::pair<int, Component *>> s_componentInitQueue;
+    static Vector<std::pair<int, Handle<Component>>> s_componentKillQueue;
+    static Vector<Component *> s_componentReleaseQueue;
+    static Vector<std::pair<Handle<GameObject>, bool>> s_staticQueue;
+    static Vector<size_t> s_staticCounts; // indexed by component type ID
+
+    static Vector<UniquePtr<detail::ViewBase>> s_views;
+    static Vector<Vector<detail::ViewBase *>> s_viewsByType; // indexed by component type ID
+    static std::mutex s_viewsMutex; // views can be made by systems running alongside each other
+
+    static thread_local detail::SceneLane * s_lane;
+    static std::mutex s_laneMutex; // guards pools while lanes are in use
+
+    static thread_local bool s_loadingLevel;
+    static int s_levelCapacity; // objects the level regions are sized for
+    static Vector<Handle<GameObject>> s_levelGameObjects;
+    static bool s_levelUnloaded; // level regions can be rewound once the frame's kills are done
+
+    static Vector<UniquePtr<detail::MessageQueueBase>> s_messageQueues; // indexed by message type ID
+    static Vector<Vector<Receiver>> s_receivers; // indexed by message type ID
+    static uint32_t s_nextReceiverID;
+    static Component * s_initComponent; // component whose init is running, if any
+    static bool s_deadReceivers; // some scene-level receivers need clearing out
+    static Vector<Handle<GameObject>> s_deadReceiverObjects; // objects whose receivers need clearing out
 
   public:
 
+    // per system timings are kept by the scheduler
     static float totalDT;
     static float initDT;
     static float killDT;
-    static float gameDT;
-    static float gameMessagingDT;
-    static float spatialDT;
-    static float spatialMessagingDT;
-    static float pathfindingDT;
-    static float pathfindingMessagingDT;
-    static float collisionDT;
-    static float collisionMessagingDT;
-    static float postCollisionDT;
-    static float postCollisionMessagingDT;
-    static float particleDT;
-    static float particleMessagingDT;
-    static float renderDT;
-    static float renderMessagingDT;
-    static float soundDT;
-    static float soundMessagingDT;
 
     static bool mapping;
     static String mapFilename;
@@ -122,8 +293,21 @@ CompT & Scene::addComponentAs(GameObject & gameObject, Args &&... args) {
     static_assert(std::is_base_of<SuperT, CompT>::value, "CompT must be derived from SuperT");
     static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
 
-    s_componentInitQueue.emplace_back(typeid(SuperT), UniquePtr<CompT>::make(CompT(gameObject, std::forward<Args>(args)...)));
-    return static_cast<CompT &>(*s_componentInitQueue.back().second);
+    MemoryScope memoryScope(MemoryCategory::Scene);
+    // constructed in place so the component never moves
+    CompT * comp(new (allocate(componentPool<CompT>())) CompT(gameObject, std::forward<Args>(args)...));
+    comp->m_poolID = TypeIDs<Component>::get<CompT>();
+    (s_lane ? s_lane->componentInitQueue : s_componentInitQueue).emplace_back(TypeIDs<Component>::get<SuperT>(), comp);
+    return *comp;
+}
+
+template <typename T>
+void * Scene::allocate(Pool<T> & pool) {
+    std::unique_lock<std::mutex> lock(s_laneMutex, std::defer_lock);
+    if (s_lane) {
+        lock.lock();
+    }
+    return s_loadingLevel ? pool.allocateLevel(size_t(s_levelCapacity)) : pool.allocate();
 }
 
 template <typename CompT>
@@ -131,27 +315,42 @@ void Scene::removeComponent(CompT & component) {
     static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
     static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
 
-    assert(s_components.count(typeid(CompT))); // trying to remove a type of component that was never added
-    s_componentKillQueue.emplace_back(typeid(CompT), static_cast<Component *>(&component));
+    (s_lane ? s_lane->componentKillQueue : s_componentKillQueue).emplace_back(TypeIDs<Component>::get<CompT>(), getHandle(component));
 }
 
 template<typename MsgT, typename... Args>
 void Scene::sendMessage(const GameObject * gameObject, Args &&... args) {
     static_assert(std::is_base_of<Message, MsgT>::value, "MsgT must be a message type");
 
-    s_messages.emplace_back(gameObject, typeid(MsgT), UniquePtr<Message>::makeAs<MsgT>(std::forward<Args>(args)...));
+    MemoryScope memoryScope(MemoryCategory::Messages);
+    auto & queue(s_lane ? messageQueue<MsgT>(*s_lane) : messageQueue<MsgT>());
+    queue.messages.emplace_back(gameObject, std::forward<Args>(args)...);
 }
 
-template <typename MsgT>
-void Scene::addReceiver(const GameObject * gameObject, const std::function<void (const Message &)> & receiver) {
+template <typename MsgT, typename F>
+ReceiverHandle Scene::addReceiver(const GameObject * gameObject, const F & receiver) {
     static_assert(std::is_base_of<Message, MsgT>::value, "MsgT must be a message type");
 
-    if (gameObject) {
-        const_cast<GameObject *>(gameObject)->m_receivers[std::type_index(typeid(MsgT))].emplace_back(receiver);
+    MemoryScope memoryScope(MemoryCategory::Messages);
+    int typeID(TypeIDs<Message>::get<MsgT>());
+    auto & receivers(gameObject ? const_cast<GameObject *>(gameObject)->m_receivers : s_receivers);
+    if (typeID >= int(receivers.size())) {
+        receivers.resize(typeID + 1);
     }
-    else {
-        s_receivers[std::type_index(typeid(MsgT))].emplace_back(receiver);
+    uint32_t id(s_nextReceiverID++);
+    receivers[typeID].push_back(Receiver::make<MsgT>(receiver, s_initComponent, id));
+    if (s_initComponent) {
+        s_initComponent->m_hasReceivers = true;
     }
+
+    ReceiverHandle handle;
+    if (gameObject) {
+        handle.m_gameObject = getHandle(*const_cast<GameObject *>(gameObject));
+    }
+    handle.m_global = !gameObject;
+    handle.m_msgTypeID = typeID;
+    handle.m_id = id;
+    return handle;
 }
 
 template <typename CompT>
@@ -159,14 +358,143 @@ const Vector<CompT *> & Scene::getComponents() {
     static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
     static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
 
-    std::type_index typeI(typeid(CompT));
-    auto it(s_components.find(typeI));
-    if (it == s_components.end()) {
-        s_components.emplace(typeI, UniquePtr<Vector<UniquePtr<Component>>>::make());
-        it = s_components.find(typeI);
+    static const Vector<Component *> & s_comps(componentList(TypeIDs<Component>::get<CompT>()));
+    return reinterpret_cast<const Vector<CompT *> &>(s_comps);
+}
+
+template <typename CompT>
+const Vector<CompT *> & Scene::getComponentsOfType() {
+    static_assert(std::is_base_of<Component, CompT>::value, "CompT must be a component type");
+    static_assert(!std::is_same<CompT, Component>::value, "CompT must be a derived component type");
+
+    static const Vector<Component *> & s_comps(concreteList(TypeIDs<Component>::get<CompT>()));
+    return reinterpret_cast<const Vector<CompT *> &>(s_comps);
+}
+
+template <typename BaseT, typename... CompTs>
+void Scene::updateComponents(float dt) {
+    using Batch = typename std::conditional<sizeof...(CompTs) == 0, detail::ComponentBatch<BaseT>, detail::ComponentBatch<CompTs...>>::type;
+
+    const Vector<BaseT *> & comps(getComponents<BaseT>());
+    if (Batch::template update<BaseT>(dt) + staticCount(TypeIDs<Component>::get<BaseT>()) < comps.size()) {
+        for (BaseT * comp : comps) {
+            if (!comp->m_isStatic && !Batch::contains(comp->m_poolID)) {
+                comp->update(dt);
+            }
+        }
     }
-    // this is valid because unique_ptr<T> is exactly the same data as T *
-    return reinterpret_cast<const Vector<CompT *> &>(*(it->second));
+}
+
+template <typename... CompTs>
+View<CompTs...> Scene::view() {
+    static_assert(sizeof...(CompTs) > 0, "a view needs at least one component type");
+
+    static const detail::ViewBase & s_view(makeView({ TypeIDs<Component>::get<CompTs>()... }));
+    return View<CompTs...>(s_view);
+}
+
+template <typename CompT>
+Pool<CompT> & Scene::componentPool() {
+    static detail::ComponentPool<CompT> * s_pool(nullptr);
+
+    // lanes can be the first to use a type at the same time
+    std::unique_lock<std::mutex> lock(s_laneMutex, std::defer_lock);
+    if (s_lane) {
+        lock.lock();
+    }
+    if (!s_pool) {
+        int typeID(TypeIDs<Component>::get<CompT>());
+        if (typeID >= int(s_componentPools.size())) {
+            s_componentPools.resize(typeID + 1);
+        }
+        s_componentPools[typeID] = UniquePtr<detail::ComponentPoolBase>::makeAs<detail::ComponentPool<CompT>>();
+        s_pool = static_cast<detail::ComponentPool<CompT> *>(s_componentPools[typeID].get());
+    }
+    return s_pool->pool;
+}
+
+template <typename MsgT>
+detail::MessageQueue<MsgT> & Scene::messageQueue() {
+    static detail::MessageQueue<MsgT> * s_queue(nullptr);
+
+    if (!s_queue) {
+        int typeID(TypeIDs<Message>::get<MsgT>());
+        if (typeID >= int(s_messageQueues.size())) {
+            s_messageQueues.resize(typeID + 1);
+        }
+        s_messageQueues[typeID] = UniquePtr<detail::MessageQueueBase>::makeAs<detail::MessageQueue<MsgT>>();
+        s_queue = static_cast<detail::MessageQueue<MsgT> *>(s_messageQueues[typeID].get());
+    }
+    return *s_queue;
+}
+
+template <typename MsgT>
+detail::MessageQueue<MsgT> & Scene::messageQueue(detail::SceneLane & lane) {
+    int typeID(TypeIDs<Message>::get<MsgT>());
+    if (typeID >= int(lane.messageQueues.size())) {
+        lane.messageQueues.resize(typeID + 1);
+    }
+    if (!lane.messageQueues[typeID]) {
+        lane.messageQueues[typeID] = UniquePtr<detail::MessageQueueBase>::makeAs<detail::MessageQueue<MsgT>>();
+    }
+    return static_cast<detail::MessageQueue<MsgT> &>(*lane.messageQueues[typeID]);
+}
+
+template <typename MsgT>
+int detail::MessageQueue<MsgT>::relay() {
+    if (messages.empty()) {
+        return 0;
+    }
+    // this keeps things from breaking if messages are sent from receivers
+    std::swap(messages, relaying);
+    int typeID(TypeIDs<Message>::get<MsgT>());
+    for (Entry & entry : relaying) {
+        Scene::relayMessage(entry.gameObject, typeID, entry.msg);
+    }
+    int n(int(relaying.size()));
+    relaying.clear();
+    return n;
+}
+
+template <typename MsgT>
+void detail::MessageQueue<MsgT>::merge() {
+    auto & queue(Scene::messageQueue<MsgT>().messages);
+    for (Entry & entry : messages) {
+        queue.push_back(entry);
+    }
+    messages.clear();
+}
+
+
+
+namespace detail {
+
+template <>
+struct ComponentBatch<> {
+    template <typename BaseT> static size_t update(float) { return 0; }
+    static bool contains(int) { return false; }
+};
+
+template <typename CompT, typename... CompTs>
+struct ComponentBatch<CompT, CompTs...> {
+
+    // Returns how many components were updated
+    template <typename BaseT>
+    static size_t update(float dt) {
+        static_assert(std::is_base_of<BaseT, CompT>::value, "CompT must be derived from BaseT");
+        const Vector<CompT *> & comps(Scene::getComponentsOfType<CompT>());
+        for (CompT * comp : comps) {
+            comp->CompT::update(dt); // qualified, so not virtual
+        }
+        return comps.size() + ComponentBatch<CompTs...>::template update<BaseT>(dt);
+    }
+
+    static bool contains(int poolID) {
+        return poolID == TypeIDs<Component>::get<CompT>() || ComponentBatch<CompTs...>::contains(poolID);
+    }
+
+};
+
 }
 
 
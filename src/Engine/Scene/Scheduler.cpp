@@ -0,0 +1,78 @@
+#include "Scheduler.hpp"
+
+#include "Scene.hpp"
+#include "Util/Util.hpp"
+#include "Util/JobSystem.hpp"
+#include "Util/Profiler.hpp"
+
+
+
+Vector<Scheduler::Task> Scheduler::s_tasks;
+Vector<UniquePtr<detail::SceneLane>> Scheduler::s_lanes;
+float Scheduler::s_dt;
+
+void Scheduler::add(const String & name, void (*update)(float), uint64_t reads, uint64_t writes, bool mainThread) {
+    // never goes before the previous task, and goes after any it conflicts with
+    int wave(s_tasks.size() ? s_tasks.back().wave : 0);
+    for (const Task & task : s_tasks) {
+        if ((writes & (task.reads | task.writes)) || (reads & task.writes)) {
+            wave = glm::max(wave, task.wave + 1);
+        }
+    }
+    s_tasks.push_back(Task{ name, update, reads, writes, mainThread, wave, 0.0f, 0.0f });
+    s_lanes.emplace_back(UniquePtr<detail::SceneLane>::make());
+}
+
+void Scheduler::update(float dt) {
+    s_dt = dt;
+    int n(int(s_tasks.size()));
+    for (int first(0), last; first < n; first = last) {
+        last = first + 1;
+        while (last < n && s_tasks[last].wave == s_tasks[first].wave) {
+            ++last;
+        }
+
+        if (last - first == 1) {
+            // nothing to run alongside, so no need for a lane
+            runTask(&s_tasks[first], 0, 0);
+        }
+        else {
+            JobCounter counter;
+            for (int i(first); i < last; ++i) {
+                if (!s_tasks[i].mainThread) {
+                    JobSystem::run(&runTask, &s_tasks[i], i, i + 1, counter);
+                }
+            }
+            for (int i(first); i < last; ++i) {
+                if (s_tasks[i].mainThread) {
+                    runTask(&s_tasks[i], i, i + 1);
+                }
+            }
+            JobSystem::wait(counter);
+            // hand over in the order the tasks were added, whichever finished first
+            for (int i(first); i < last; ++i) {
+                Scene::mergeLane(*s_lanes[i]);
+            }
+        }
+
+        Util::Stopwatch watch;
+        Scene::relayMessages();
+        float messagingDT(float(watch.lap()));
+        for (int i(first); i < last; ++i) {
+            s_tasks[i].messagingDT = messagingDT;
+        }
+    }
+}
+
+void Scheduler::runTask(const void * task_, int begin, int end) {
+    Task & task(*const_cast<Task *>(static_cast<const Task *>(task_)));
+    // an empty range means the task is running by itself
+    if (begin != end) {
+        Scene::setLane(s_lanes[begin].get());
+    }
+    PROFILE_ZONE(task.name.c_str()); // tasks are only added during init, so the name stays put
+    Util::Stopwatch watch;
+    task.update(s_dt);
+    task.updateDT = float(watch.lap());
+    Scene::setLane(nullptr);
+}
@@ -0,0 +1,101 @@
+/* Scheduler
+ * Decides which systems can be updated at the same time and runs them */
+#pragma once
+#ifndef _SCHEDULER_HPP_
+#define _SCHEDULER_HPP_
+
+
+
+#include <cstdint>
+#include <cassert>
+
+#include "Util/Memory.hpp"
+#include "Util/TypeID.hpp"
+#include "System/System.hpp"
+
+class Scene;
+class Component;
+namespace detail { struct SceneLane; }
+
+
+
+// static class
+class Scheduler {
+
+    friend Scene;
+
+    public:
+
+    struct Task {
+        String name;
+        void (*update)(float);
+        uint64_t reads, writes; // bit per component type
+        bool mainThread;
+        int wave; // tasks of the same wave are updated together
+        float updateDT; // time spent updating, this frame
+        float messagingDT; // time spent relaying messages after the task's wave, this frame
+    };
+
+    // Adds a system to be updated every frame. Systems are updated in the
+    // order they are added, except that a system may be updated alongside the
+    // one before it when it doesn't read or write anything that one writes,
+    // and vice versa. Messages are relayed between each group of systems.
+    // If mainThread, the system is never updated on a worker thread
+    template <typename SystemT> static void add(const String & name, bool mainThread = false);
+
+    static const Vector<Task> & tasks() { return s_tasks; }
+
+    private:
+
+    static void add(const String & name, void (*update)(float), uint64_t reads, uint64_t writes, bool mainThread);
+
+    // Updates every system, relaying messages after each wave
+    static void update(float dt);
+
+    static void runTask(const void * task, int, int);
+
+    // Bit mask of the component types
+    template <typename CompT> static uint64_t bit();
+    template <typename... CompTs> static uint64_t mask(ComponentTypes<CompTs...>);
+    static uint64_t mask(AllComponents) { return ~uint64_t(0); }
+
+    private:
+
+    static Vector<Task> s_tasks;
+    static Vector<UniquePtr<detail::SceneLane>> s_lanes; // indexed by task
+    static float s_dt;
+
+};
+
+
+
+// TEMPLATE IMPLEMENTATION /////////////////////////////////////////////////////
+
+
+
+template <typename SystemT>
+void Scheduler::add(const String & name, bool mainThread) {
+    add(name, &SystemT::update, mask(typename SystemT::Reads()), mask(typename SystemT::Writes()), mainThread);
+}
+
+template <typename CompT>
+uint64_t Scheduler::bit() {
+    int typeID(TypeIDs<Component>::get<CompT>());
+    assert(typeID < 64); // too many component types to fit in a mask
+    return uint64_t(1) << typeID;
+}
+
+template <typename... CompTs>
+uint64_t Scheduler::mask(ComponentTypes<CompTs...>) {
+    // expands to one bit per type
+    uint64_t bits[]{ 0, bit<CompTs>()... };
+    uint64_t m(0);
+    for (uint64_t b : bits) {
+        m |= b;
+    }
+    return m;
+}
+
+
+
+#endif
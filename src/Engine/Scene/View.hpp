@@ -0,0 +1,118 @@
+/* View
+ * Cached list of the game objects that have each of a set of component types */
+#pragma once
+#ifndef _VIEW_HPP_
+#define _VIEW_HPP_
+
+
+
+#include <cstdint>
+#include <type_traits>
+
+#include "Util/Memory.hpp"
+
+class GameObject;
+class Component;
+
+
+
+namespace detail {
+
+// Kept up to date by the scene as components are added and removed
+struct ViewBase {
+    uint64_t mask; // bit per component type
+    Vector<int> typeIDs;
+    Vector<GameObject *> gameObjects;
+    Vector<Component *> components; // first of each type, typeIDs.size() per game object
+    UnorderedMap<const GameObject *, int> indices; // position in gameObjects
+};
+
+// Position of T in Ts
+template <typename T, typename... Ts> struct TypeIndex;
+
+template <typename T, typename... Ts>
+struct TypeIndex<T, T, Ts...> : std::integral_constant<int, 0> {};
+
+template <typename T, typename U, typename... Ts>
+struct TypeIndex<T, U, Ts...> : std::integral_constant<int, 1 + TypeIndex<T, Ts...>::value> {};
+
+}
+
+
+
+// The game objects that have at least one component of each of CompTs, along
+// with the first of each, in no particular order. Get one from Scene::view
+template <typename... CompTs>
+class View {
+
+    public:
+
+    class Entry {
+
+        friend View;
+
+        public:
+
+        GameObject & gameObject() const { return *m_gameObject; }
+
+        // The object's first component of the type, which must be one of CompTs
+        template <typename CompT> CompT & get() const {
+            return *static_cast<CompT *>(m_components[detail::TypeIndex<CompT, CompTs...>::value]);
+        }
+
+        private:
+
+        Entry(GameObject * gameObject, Component * const * components) :
+            m_gameObject(gameObject),
+            m_components(components)
+        {}
+
+        private:
+
+        GameObject * m_gameObject;
+        Component * const * m_components;
+
+    };
+
+    class Iterator {
+
+        friend View;
+
+        public:
+
+        Entry operator*() const { return m_view[m_i]; }
+        Iterator & operator++() { ++m_i; return *this; }
+        bool operator!=(const Iterator & other) const { return m_i != other.m_i; }
+
+        private:
+
+        Iterator(const View & view, int i) : m_view(view), m_i(i) {}
+
+        private:
+
+        const View & m_view;
+        int m_i;
+
+    };
+
+    explicit View(const detail::ViewBase & view) : m_view(view) {}
+
+    int size() const { return int(m_view.gameObjects.size()); }
+    bool empty() const { return m_view.gameObjects.empty(); }
+
+    Entry operator[](int i) const {
+        return Entry(m_view.gameObjects[i], m_view.components.data() + i * int(sizeof...(CompTs)));
+    }
+
+    Iterator begin() const { return Iterator(*this, 0); }
+    Iterator end() const { return Iterator(*this, size()); }
+
+    private:
+
+    const detail::ViewBase & m_view;
+
+};
+
+
+
+#endif
@@ -209,7 +209,7 @@ void DiffuseShader::render(const CameraComponent * camera) {
     glTexSubImage1D(GL_TEXTURE_1D, 0, 0, int(cellSpecularScales.size()), GL_RED, GL_FLOAT, cellSpecularScales.data());
 
     /* Get render targets */
-    Vector<DiffuseRenderComponent *> components;
+    FrameVector<DiffuseRenderComponent *> components;
     RenderSystem::getFrustumComps(camera, components);
 
     /* Iterate through render targets */
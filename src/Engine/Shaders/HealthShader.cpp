@@ -60,19 +60,18 @@ void HealthShader::render(const CameraComponent * camera) {
 
     loadVec2(getUniform("size"), m_size);
 
-    /* Iterate through all enemies */
-    auto enemies = Scene::getComponents<EnemyComponent>();
-    for (auto enemy : enemies) {
-        auto health = enemy->gameObject().getComponentByType<HealthComponent>();
-        auto spatials = enemy->gameObject().getComponentsByType<SpatialComponent>();
-        if (!health || spatials.size() < 2) {
+    /* Iterate through all enemies with health */
+    for (auto enemy : Scene::view<EnemyComponent, HealthComponent>()) {
+        HealthComponent & health(enemy.get<HealthComponent>());
+        auto spatials = enemy.gameObject().getComponentsByType<SpatialComponent>();
+        if (spatials.size() < 2) {
             return;
         }
 
         /* Store health params */
-        loadFloat(getUniform("minVal"), health->minValue());
-        loadFloat(getUniform("curVal"), health->value());
-        loadFloat(getUniform("maxVal"), health->maxValue());
+        loadFloat(getUniform("minVal"), health.minValue());
+        loadFloat(getUniform("curVal"), health.value());
+        loadFloat(getUniform("maxVal"), health.maxValue());
 
         /* Find position based on hierarchy */
         loadVec3(getUniform("center"), spatials[1]->position() + glm::vec3(0.0f, 0.75f, 0.0f));
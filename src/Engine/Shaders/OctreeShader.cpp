@@ -64,21 +64,18 @@ void OctreeShader::render(const CameraComponent * camera) {
     loadMat4(getUniform("u_viewMat"), camera->getView());
     loadMat4(getUniform("u_projMat"), camera->getProj());
 
-    Octree<const BounderComponent *> & octree(*CollisionSystem::s_octree);
-    int maxDepth(Util::log2Floor(int(std::round(octree.m_root->radius / octree.m_minRadius))) - 1);
-    renderNode(camera, CollisionSystem::s_octree->m_root.get(), 0, maxDepth);
+    const Octree<const BounderComponent *> & octree(*CollisionSystem::s_octree);
+    int maxDepth(Util::log2Floor(int(std::round(octree.m_nodes.front().radius / octree.m_minRadius))) - 1);
+    renderNode(camera, octree, 0, 0, maxDepth);
 
     glBindVertexArray(0);
     unbind();
 }
 
-void OctreeShader::renderNode(const CameraComponent * camera, const void * node_, int depth, int maxDepth) {
+void OctreeShader::renderNode(const CameraComponent * camera, const Octree<const BounderComponent *> & octree, unsigned int node_, int depth, int maxDepth) {
     static const float sqrt3(std::sqrt(3.0f));
 
-    // Using void * and this cast because I really don't want OctreeShader.hpp
-    // to include Octree.hpp, for compilation time concerns, and you can't
-    // forward declare an inner class
-    const Octree<BounderComponent *>::Node & node(*static_cast<const Octree<BounderComponent *>::Node *>(node_));
+    const Octree<const BounderComponent *>::Node & node(octree.m_nodes[node_]);
 
     // View frustum culling
     if (!camera->sphereInFrustum(Sphere(node.center, sqrt3 * node.radius))) {
@@ -91,10 +88,10 @@ void OctreeShader::renderNode(const CameraComponent * camera, const void * node_
     loadVec3(getUniform("u_color"), glm::mix(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 1.0f), d));
     glDrawElements(GL_LINES, m_nAABIndices, GL_UNSIGNED_INT, nullptr);
 
-    if (node.children) {
+    if (node.children != Octree<const BounderComponent *>::k_none) {
         for (unsigned char o(0), op(1); o < 8; ++o, op <<= 1) {
             if (node.activeOs & op) {
-                renderNode(camera, &node.children[o], depth + 1, maxDepth);
+                renderNode(camera, octree, node.children + o, depth + 1, maxDepth);
             }
         }
     }
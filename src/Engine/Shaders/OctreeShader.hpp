@@ -9,6 +9,7 @@
 class DiffuseRenderComponent;
 class CameraComponent;
 class BounderComponent;
+template <typename T> class Octree;
 
 
 
@@ -24,7 +25,7 @@ class OctreeShader : public Shader {
 
     private:
 
-    void renderNode(const CameraComponent * camera, const void * node, int depth, int maxDepth);
+    void renderNode(const CameraComponent * camera, const Octree<const BounderComponent *> & octree, unsigned int node, int depth, int maxDepth);
 
     bool initAABMesh();
 
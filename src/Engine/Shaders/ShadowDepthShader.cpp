@@ -155,7 +155,7 @@ void ShadowDepthShader::render(const CameraComponent * camera) {
     this->L = camera->getProj() * camera->getView();
     loadMat4(getUniform("L"), L);
 
-    Vector<DiffuseRenderComponent *> components;
+    FrameVector<DiffuseRenderComponent *> components;
     RenderSystem::getFrustumComps(camera, components);
     for (auto drc : components) {
     
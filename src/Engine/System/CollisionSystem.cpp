@@ -7,9 +7,13 @@
 
 #include "Component/SpatialComponents/SpatialComponent.hpp"
 #include "Component/CollisionComponents/BounderComponent.hpp"
+#include "Component/SpatialComponents/PhysicsComponents.hpp"
 #include "Scene/Scene.hpp"
+#include "Util/BVH.hpp"
 #include "Util/Octree.hpp"
+#include "Util/SweepAndPrune.hpp"
 #include "Util/Util.hpp"
+#include "Util/Profiler.hpp"
 
 
 
@@ -40,7 +44,14 @@ struct Collision {
 
 
 
-bool collide(const BounderComponent & b1, const BounderComponent & b2, UnorderedMap<const BounderComponent *, Vector<std::pair<int, glm::vec3>>> * collisions) {
+// A sleeping body is held in place, so it holds its ground against bodies no
+// heavier than itself
+bool isAsleep(const BounderComponent & bounder) {
+    const NewtonianComponent * newtonian(bounder.gameObject().getComponentByType<NewtonianComponent>());
+    return newtonian && newtonian->isAsleep();
+}
+
+bool collide(const BounderComponent & b1, const BounderComponent & b2, FrameUnorderedMap<const BounderComponent *, FrameVector<std::pair<int, glm::vec3>>> * collisions) {
     if (b1.weight() == UINT_MAX && b2.weight() == UINT_MAX) {
         return false;
     }
@@ -61,11 +72,18 @@ bool collide(const BounderComponent & b1, const BounderComponent & b2, Unordered
     if (!b1.collide(b2, &delta)) {
         return false;
     }    
-    if (b1.weight() < b2.weight()) {
+    bool b1Yields(b1.weight() < b2.weight()), b2Yields(b2.weight() < b1.weight());
+    if (!b1Yields && !b2Yields) {
+        // equal weights split the difference, unless just one is asleep
+        bool b1Asleep(isAsleep(b1)), b2Asleep(isAsleep(b2));
+        b1Yields = b2Asleep && !b1Asleep;
+        b2Yields = b1Asleep && !b2Asleep;
+    }
+    if (b1Yields) {
         (*collisions)[&b1].push_back(std::make_pair(b2.weight(), delta));
         if (b2.weight() != UINT_MAX) (*collisions)[&b2];
     }
-    else if (b2.weight() < b1.weight()) {
+    else if (b2Yields) {
         if (b1.weight() != UINT_MAX) (*collisions)[&b1];
         (*collisions)[&b2].push_back(std::make_pair(b1.weight(), -delta));
     }
@@ -108,7 +126,7 @@ bool compWeightDelta(const std::pair<int, glm::vec3> & d1, const std::pair<int,
 // weight takes precidence. But this doesn't mean you ignore the lower weight
 // delta. Rather, you "hemispherically clamp" the net lower weight delta
 // onto each higher weight delta, and repeat this process, moving up in weight.
-glm::vec3 detNetDelta(Vector<std::pair<int, glm::vec3>> & weightDeltas) {
+glm::vec3 detNetDelta(FrameVector<std::pair<int, glm::vec3>> & weightDeltas) {
     if (weightDeltas.size() == 0) {
         return glm::vec3();
     }
@@ -150,73 +168,105 @@ const Vector<BounderComponent *> & CollisionSystem::s_bounderComponents(Scene::g
 UnorderedSet<BounderComponent *> CollisionSystem::s_potentials;
 UnorderedSet<const BounderComponent *> CollisionSystem::s_collided;
 UnorderedSet<const BounderComponent *> CollisionSystem::s_adjusted;
-UniquePtr<Octree<const BounderComponent *>> CollisionSystem::s_octree;
+UniquePtr<Broadphase<const BounderComponent *>> CollisionSystem::s_broadphase;
+Octree<const BounderComponent *> * CollisionSystem::s_octree(nullptr);
+UniquePtr<BVH<const BounderComponent *>> CollisionSystem::s_statics;
+bool CollisionSystem::s_staticsChanged(false);
 int CollisionSystem::s_nPicks = 0;
 
 void CollisionSystem::init() {
+    s_statics = UniquePtr<BVH<const BounderComponent *>>::make();
+
     auto compAddedCallback(
-        [&](const Message & msg_) {
-            const ComponentAddedMessage & msg(static_cast<const ComponentAddedMessage &>(msg_));            
-            if (msg.typeI == typeid(BounderComponent)) {
+        [&](const ComponentAddedMessage & msg) {
+            if (msg.typeID == TypeIDs<Component>::get<BounderComponent>()) {
                 BounderComponent & bounder(static_cast<BounderComponent &>(msg.comp));
                 s_potentials.insert(&bounder);
+                if (bounder.isStatic()) {
+                    // its region goes in the hierarchy before its first update
+                    bounder.update(0.0f);
+                    bounder.m_isInStatics = true;
+                    s_staticsChanged = true;
+                }
             }
         }
     );
     Scene::addReceiver<ComponentAddedMessage>(nullptr, compAddedCallback);
 
     auto compRemovedCallback(
-        [&](const Message & msg_) {
-            const ComponentRemovedMessage & msg(static_cast<const ComponentRemovedMessage &>(msg_));            
-            if (msg.typeI == typeid(BounderComponent)) {
-                BounderComponent & bounder(const_cast<BounderComponent &>(static_cast<const BounderComponent &>(*msg.comp)));
+        [&](const ComponentRemovedMessage & msg) {
+            if (msg.typeID == TypeIDs<Component>::get<BounderComponent>()) {
+                BounderComponent & bounder(static_cast<BounderComponent &>(msg.comp));
                 s_potentials.erase(&bounder);
-                if (s_octree) s_octree->remove(&bounder);
+                if (bounder.m_isInStatics) {
+                    // taken out now, as picks can come before the rebuild
+                    s_statics->remove(&bounder);
+                    bounder.m_isInStatics = false;
+                    s_staticsChanged = true;
+                }
+                else if (s_broadphase) {
+                    // anything asleep on or against it could now fall. Its game
+                    // object may already be gone, so only the bounder is used
+                    if (!bounder.isStatic()) wakeAround(bounder);
+                    s_broadphase->remove(&bounder);
+                }
             }
         }
     );
     Scene::addReceiver<ComponentRemovedMessage>(nullptr, compRemovedCallback);
 
     auto spatTransformCallback(
-        [&](const Message & msg_) {
-            const SpatialChangeMessage & msg(static_cast<const SpatialChangeMessage &>(msg_));
-            for (auto & comp : msg.spatial.gameObject().getComponentsByType<BounderComponent>()) {
-                BounderComponent & bounder(static_cast<BounderComponent &>(*comp));
-                s_potentials.insert(&bounder);
+        [&](const SpatialChangesMessage & msg) {
+            for (const SpatialComponent * spatial : msg.spatials) {
+                for (BounderComponent * bounder : spatial->gameObject().getComponentsByType<BounderComponent>()) {
+                    s_potentials.insert(bounder);
+                }
             }
         }
     );
-    Scene::addReceiver<SpatialChangeMessage>(nullptr, spatTransformCallback);
+    Scene::addReceiver<SpatialChangesMessage>(nullptr, spatTransformCallback);
 }
 
 void CollisionSystem::update(float dt) {
-    static UnorderedMap<const BounderComponent *, Vector<std::pair<int, glm::vec3>>> s_collisions;
-    static UnorderedSet<const BounderComponent *> s_criticals;
-    static UnorderedSet<const BounderComponent *> s_criticalZeroes;
-    static Vector<const BounderComponent *> s_yanked;
+    // these hold on to their capacity, so don't allocate once warmed up
     static Vector<const BounderComponent *> s_passed;
-    static UnorderedSet<const BounderComponent *> s_checked;
-    static UnorderedMap<const GameObject *, glm::vec3> s_gameObjectDeltas;
-    static Vector<const BounderComponent *> s_octreeResults;
-    static UnorderedSet<GameObject *> s_outOfBounds;
+    static Vector<const BounderComponent *> s_broadphaseResults;
+    // whereas these would allocate per element, so come from the frame arena
+    FrameUnorderedMap<const BounderComponent *, FrameVector<std::pair<int, glm::vec3>>> collisions;
+    FrameUnorderedSet<const BounderComponent *> criticals;
+    FrameUnorderedSet<const BounderComponent *> criticalZeroes;
+    FrameVector<const BounderComponent *> yanked;
+    FrameUnorderedSet<const BounderComponent *> checked;
+    FrameUnorderedMap<const GameObject *, glm::vec3> gameObjectDeltas;
+    FrameUnorderedSet<GameObject *> outOfBounds;
 
     s_nPicks = 0;
+    MemoryScope memoryScope(MemoryCategory::Collision);
 
-    // update all potential bounders
-    for (BounderComponent * bounder : s_potentials) {
-        bounder->update(dt);
-    }
+    {
+        PROFILE_ZONE("Update bounders");
+        // update all potential bounders
+        for (BounderComponent * bounder : s_potentials) {
+            bounder->update(dt);
+        }
 
-    // update octree
-    if (s_octree) {
-        s_outOfBounds.clear();
+        // update broadphase
         for (BounderComponent * bounder : s_potentials) {
-            if (!s_octree->set(bounder, bounder->enclosingAABox())) {
-                s_outOfBounds.insert(&bounder->gameObject());
+            if (bounder->m_isInStatics) {
+                if (bounder->isStatic()) {
+                    continue;
+                }
+                // made dynamic, so it goes in with everything else
+                bounder->m_isInStatics = false;
+                s_staticsChanged = true;
+            }
+            if (s_broadphase && !s_broadphase->set(bounder, bounder->enclosingAABox())) {
+                outOfBounds.insert(&bounder->gameObject());
             }
         }
+        updateStatics();
         // remove all out of bounds game objects
-        for (GameObject * go : s_outOfBounds) {
+        for (GameObject * go : outOfBounds) {
             const auto & bounders(go->getComponentsByType<BounderComponent>());
             for (BounderComponent * bounder : bounders) {
                 s_potentials.erase(bounder);
@@ -225,157 +275,188 @@ void CollisionSystem::update(float dt) {
         }
     }
 
-    // determine all bounders with path intersections
-    s_criticals.clear();
-    s_criticalZeroes.clear();
-    for (BounderComponent * bounder : s_potentials) {
-        if (bounder->isCritical()) {
-            s_criticals.insert(bounder);
-            if (bounder->weight() == 0) s_criticalZeroes.insert(bounder);
-        }
-    }
-    // determine path intersection corrections per game object
-    s_gameObjectDeltas.clear();
-    for (const BounderComponent * bounder : s_criticals) {
-        if (bounder->weight() == 0) {
-            continue;
+    {
+        PROFILE_ZONE("Path intersections");
+        // determine all bounders with path intersections
+        for (BounderComponent * bounder : s_potentials) {
+            if (bounder->isCritical()) {
+                criticals.insert(bounder);
+                if (bounder->weight() == 0) criticalZeroes.insert(bounder);
+            }
         }
-        glm::vec3 delta(bounder->center() - bounder->prevCenter());
-        float dist(glm::length(delta));
-        Ray ray(bounder->prevCenter(), delta / dist);
-        auto pair(pickHeavy(
-            ray,
-            1,
-            // do not intersect other critical bounders. critical-critical collision hella unsupported
-            [&](const BounderComponent & b) {
-                return s_criticals.count(&b) == 0;
+        // determine path intersection corrections per game object
+        for (const BounderComponent * bounder : criticals) {
+            if (bounder->weight() == 0) {
+                continue;
+            }
+            glm::vec3 delta(bounder->center() - bounder->prevCenter());
+            float dist(glm::length(delta));
+            Ray ray(bounder->prevCenter(), delta / dist);
+            auto pair(pickHeavy(
+                ray,
+                1,
+                // do not intersect other critical bounders. critical-critical collision hella unsupported
+                [&](const BounderComponent & b) {
+                    return criticals.count(&b) == 0;
+                }
+            ));
+            Intersect & inter(pair.second);
+            if (inter.is && inter.dist * inter.dist < dist * dist) {
+                glm::vec3 & d(gameObjectDeltas[&bounder->gameObject()]);
+                d = compositeDeltas(d, pair.second.pos - bounder->center());
             }
-        ));
-        Intersect & inter(pair.second);
-        if (inter.is && inter.dist * inter.dist < dist * dist) {
-            glm::vec3 & d(s_gameObjectDeltas[&bounder->gameObject()]);
-            d = compositeDeltas(d, pair.second.pos - bounder->center());
         }
-    }
-    // apply path intersection corrections
-    s_yanked.clear();
-    for (auto & pair : s_gameObjectDeltas) {
-        if (pair.second == glm::vec3()) {
-            continue;
+        // apply path intersection corrections
+        for (auto & pair : gameObjectDeltas) {
+            if (pair.second == glm::vec3()) {
+                continue;
+            }
+            const GameObject & go(*pair.first);
+            SpatialComponent & spat(*go.getSpatial());
+            spat.move(pair.second, true);
+            for (BounderComponent * bounder : go.getComponentsByType<BounderComponent>()) {
+                yanked.push_back(bounder);
+                s_potentials.insert(bounder);
+                bounder->update(dt);
+                if (s_broadphase) {
+                    s_broadphase->set(bounder, bounder->enclosingAABox());
+                }
+            }
         }
-        const GameObject & go(*pair.first);
-        SpatialComponent & spat(*go.getSpatial());
-        spat.move(pair.second, true);
-        for (BounderComponent * bounder : go.getComponentsByType<BounderComponent>()) {
-            s_yanked.push_back(bounder);
-            s_potentials.insert(bounder);
-            bounder->update(dt);
-            if (s_octree) {
-                s_octree->set(bounder, bounder->enclosingAABox());
+        // look for path collisions with 0 weight bounders
+        for (const BounderComponent * bounder : yanked) {
+            glm::vec3 delta(bounder->center() - bounder->prevCenter());
+            float dist(glm::length(delta));
+            Ray ray(bounder->prevCenter(), delta / dist);
+            s_passed.clear();
+            pickHeavy(
+                ray,
+                1,
+                // do not intersect other critical bounders. critical-critical collision hella unsupported
+                [&](const BounderComponent & b) {
+                    return criticals.count(&b) == 0;
+                },
+                &s_passed,
+                dist
+            );
+            for (const BounderComponent * b : s_passed) {
+                Scene::sendMessage<CollisionMessage>(&bounder->gameObject(), *bounder, *b);
+                Scene::sendMessage<CollisionMessage>(&b->gameObject(), *b, *bounder);
             }
         }
-    }
-    // look for path collisions with 0 weight bounders
-    for (const BounderComponent * bounder : s_yanked) {
-        glm::vec3 delta(bounder->center() - bounder->prevCenter());
-        float dist(glm::length(delta));
-        Ray ray(bounder->prevCenter(), delta / dist);
-        s_passed.clear();
-        pickHeavy(
-            ray,
-            1,
-            // do not intersect other critical bounders. critical-critical collision hella unsupported
-            [&](const BounderComponent & b) {
-                return s_criticals.count(&b) == 0;
-            },
-            &s_passed,
-            dist
-        );
-        for (const BounderComponent * b : s_passed) {
-            Scene::sendMessage<CollisionMessage>(&bounder->gameObject(), *bounder, *b);
-            Scene::sendMessage<CollisionMessage>(&b->gameObject(), *b, *bounder);
+        // process 0 weight criticals
+        for (const BounderComponent * bounder : criticalZeroes) {
+            glm::vec3 delta(bounder->center() - bounder->prevCenter());
+            float dist(glm::length(delta));
+            Ray ray(bounder->prevCenter(), delta / dist);
+            s_passed.clear();
+            pickAll(
+                ray,
+                // do not intersect other critical bounders. critical-critical collision hella unsupported
+                [&](const BounderComponent & b) {
+                    return criticals.count(&b) == 0;
+                },
+                &s_passed,
+                dist
+            );
+            for (const BounderComponent * b : s_passed) {
+                Scene::sendMessage<CollisionMessage>(&bounder->gameObject(), *bounder, *b);
+                Scene::sendMessage<CollisionMessage>(&b->gameObject(), *b, *bounder);
+            }
         }
     }
-    // process 0 weight criticals
-    for (const BounderComponent * bounder : s_criticalZeroes) {
-        glm::vec3 delta(bounder->center() - bounder->prevCenter());
-        float dist(glm::length(delta));
-        Ray ray(bounder->prevCenter(), delta / dist);
-        s_passed.clear();
-        pickAll(
-            ray,
-            // do not intersect other critical bounders. critical-critical collision hella unsupported
-            [&](const BounderComponent & b) {
-                return s_criticals.count(&b) == 0;
-            },
-            &s_passed,
-            dist
-        );
-        for (const BounderComponent * b : s_passed) {
-            Scene::sendMessage<CollisionMessage>(&bounder->gameObject(), *bounder, *b);
-            Scene::sendMessage<CollisionMessage>(&b->gameObject(), *b, *bounder);
-        }
-    }    
 
-    // gather all collisions
-    s_collided.clear();
-    s_adjusted.clear();
-    s_checked.clear();
-    for (BounderComponent * bounder : s_potentials) {
-        s_octreeResults.clear();
-        s_checked.insert(bounder);
-        const Vector<const BounderComponent *> * possible(&reinterpret_cast<const Vector<const BounderComponent *> &>(s_bounderComponents));
-        if (s_octree) {
-            s_octree->filter(bounder, s_octreeResults);
-            possible = &s_octreeResults;
-        }
-        for (const BounderComponent * other : *possible) {
-            if (s_checked.count(other) || &other->gameObject() == &bounder->gameObject()) {
+    {
+        PROFILE_ZONE("Gather collisions");
+        // gather all collisions
+        s_collided.clear();
+        s_adjusted.clear();
+        for (BounderComponent * bounder : s_potentials) {
+            // static and sleeping bounders are found from the other side, and
+            // never collide with each other
+            if (s_broadphase && (bounder->m_isInStatics || isAsleep(*bounder))) {
                 continue;
             }
-            if (collide(*bounder, *other, &s_collisions)) {
-                Scene::sendMessage<CollisionMessage>(&bounder->gameObject(), *bounder, *other);
-                Scene::sendMessage<CollisionMessage>(&other->gameObject(), *other, *bounder);
+            checked.insert(bounder);
+            s_broadphaseResults.clear();
+            const Vector<const BounderComponent *> * possible(&reinterpret_cast<const Vector<const BounderComponent *> &>(s_bounderComponents));
+            if (s_broadphase) {
+                s_broadphase->filter(bounder, s_broadphaseResults);
+                s_statics->filter(bounder->enclosingAABox(), s_broadphaseResults);
+                possible = &s_broadphaseResults;
+            }
+            for (const BounderComponent * other : *possible) {
+                if (checked.count(other) || &other->gameObject() == &bounder->gameObject()) {
+                    continue;
+                }
+                if (collide(*bounder, *other, &collisions)) {
+                    Scene::sendMessage<CollisionMessage>(&bounder->gameObject(), *bounder, *other);
+                    Scene::sendMessage<CollisionMessage>(&other->gameObject(), *other, *bounder);
+                }
             }
         }
-    }
-    s_potentials.clear(); 
-    
-    // composite deltas into a single delta per game object
-    // additionally send norm messages
-    s_gameObjectDeltas.clear();
-    for (auto & pair : s_collisions) {
-        const BounderComponent & bounder(*pair.first);
-        auto & weightDeltas(pair.second);
-        s_collided.insert(&bounder);
-        // there was an adjustment
-        if (weightDeltas.size()) {
-            for (auto & weightDelta : weightDeltas) { // send norm messages
-                Scene::sendMessage<CollisionNormMessage>(&bounder.gameObject(), bounder, Util::safeNorm(weightDelta.second));
+        s_potentials.clear();
+    }
+
+    {
+        PROFILE_ZONE("Resolve collisions");
+        // composite deltas into a single delta per game object
+        // additionally send norm messages
+        gameObjectDeltas.clear();
+        for (auto & pair : collisions) {
+            const BounderComponent & bounder(*pair.first);
+            auto & weightDeltas(pair.second);
+            s_collided.insert(&bounder);
+            // there was an adjustment
+            if (weightDeltas.size()) {
+                for (auto & weightDelta : weightDeltas) { // send norm messages
+                    Scene::sendMessage<CollisionNormMessage>(&bounder.gameObject(), bounder, Util::safeNorm(weightDelta.second));
+                }
+                glm::vec3 & gameObjectDelta(gameObjectDeltas[&bounder.gameObject()]);
+                gameObjectDelta = compositeDeltas(gameObjectDelta, detNetDelta(weightDeltas));
             }
-            glm::vec3 & gameObjectDelta(s_gameObjectDeltas[&bounder.gameObject()]);
-            gameObjectDelta = compositeDeltas(gameObjectDelta, detNetDelta(weightDeltas));
         }
-    }
-    s_collisions.clear();
-
-    // apply deltas to game objects
-    for (auto & pair : s_gameObjectDeltas) {
-        const GameObject * gameObject(pair.first);
-        SpatialComponent & spat(*gameObject->getSpatial());
-        const glm::vec3 & delta(pair.second);
-        // set position rather than move because they are conceptually different
-        // this will come into play if we do time step interpolation
-        spat.move(delta, true);
-        for (Component * comp : gameObject->getComponentsByType<BounderComponent>()) {
-            BounderComponent * bounder(static_cast<BounderComponent *>(comp));
-            s_potentials.insert(bounder);
-            bounder->update(dt);
-            if (s_octree) {
-                s_octree->set(bounder, bounder->enclosingAABox());
+
+        // apply deltas to game objects
+        for (auto & pair : gameObjectDeltas) {
+            const GameObject * gameObject(pair.first);
+            SpatialComponent & spat(*gameObject->getSpatial());
+            const glm::vec3 & delta(pair.second);
+            // set position rather than move because they are conceptually different
+            // this will come into play if we do time step interpolation
+            spat.move(delta, true);
+            for (Component * comp : gameObject->getComponentsByType<BounderComponent>()) {
+                BounderComponent * bounder(static_cast<BounderComponent *>(comp));
+                s_potentials.insert(bounder);
+                bounder->update(dt);
+                if (s_broadphase) {
+                    s_broadphase->set(bounder, bounder->enclosingAABox());
+                }
+                s_adjusted.insert(bounder);
+                Scene::sendMessage<CollisionAdjustMessage>(gameObject, *gameObject, delta);
             }
-            s_adjusted.insert(bounder);
-            Scene::sendMessage<CollisionAdjustMessage>(gameObject, *gameObject, delta);
+        }
+    }
+}
+
+void CollisionSystem::updateStatics() {
+    if (s_staticsChanged) {
+        buildStatics();
+    }
+}
+
+void CollisionSystem::wakeAround(const BounderComponent & bounder) {
+    static Vector<const BounderComponent *> s_nearby;
+    s_nearby.clear();
+    s_broadphase->filter(&bounder, s_nearby);
+    for (const BounderComponent * other : s_nearby) {
+        // being killed along with its game object
+        if (!other->hasGameObject()) {
+            continue;
+        }
+        NewtonianComponent * newtonian(other->gameObject().getComponentByType<NewtonianComponent>());
+        if (newtonian && newtonian->isAsleep()) {
+            newtonian->wake();
         }
     }
 }
@@ -385,12 +466,12 @@ std::pair<const BounderComponent *, Intersect> CollisionSystem::pick(const Ray &
 }
 
 std::pair<const BounderComponent *, Intersect> CollisionSystem::pick(const Ray & ray, const std::function<bool(const BounderComponent &)> & conditional) {
-    static Vector<BounderComponent *> s_octreeResults;
+    static Vector<BounderComponent *> s_broadphaseResults;
 
     ++s_nPicks;
 
-    if (s_octree) {
-        return s_octree->filter(ray, [& conditional](const Ray & ray, const BounderComponent * bounder) {
+    if (s_broadphase) {
+        std::function<Intersect(const Ray &, const BounderComponent *)> f([& conditional](const Ray & ray, const BounderComponent * bounder) {
             if (conditional(*bounder)) {
                 Intersect inter(bounder->intersect(ray));
                 if (inter.face) {
@@ -399,6 +480,9 @@ std::pair<const BounderComponent *, Intersect> CollisionSystem::pick(const Ray &
             }
             return Intersect();
         });
+        auto staticPair(s_statics->filter(ray, f));
+        auto dynamicPair(s_broadphase->filter(ray, f));
+        return dynamicPair.second.dist < staticPair.second.dist ? dynamicPair : staticPair;
     }
     else {
         BounderComponent * bounder(nullptr);
@@ -506,20 +590,42 @@ std::pair<const BounderComponent *, Intersect> CollisionSystem::pickAll(
     return std::pair<const BounderComponent *, Intersect>{};
 }
 
-void CollisionSystem::setOctree(const glm::vec3 & min, const glm::vec3 & max, float minCellSize) {
-    s_octree = UniquePtr<Octree<const BounderComponent *>>::make(AABox(min, max), minCellSize);
-    for (BounderComponent * bounder : s_bounderComponents) {
-        s_octree->set(bounder, bounder->enclosingAABox());
-    }
+void CollisionSystem::setOctree(const glm::vec3 & min, const glm::vec3 & max, float minCellSize, float looseness) {
+    UniquePtr<Octree<const BounderComponent *>> octree(UniquePtr<Octree<const BounderComponent *>>::make(AABox(min, max), minCellSize, looseness));
+    s_octree = octree.get();
+    s_broadphase.release();
+    s_broadphase = std::move(octree);
+    remakeOctree();
+}
+
+void CollisionSystem::setSweepAndPrune() {
+    s_broadphase.release();
+    s_broadphase = UniquePtr<Broadphase<const BounderComponent *>>::makeAs<SweepAndPrune<const BounderComponent *>>();
+    s_octree = nullptr;
+    remakeOctree();
 }
 
 void CollisionSystem::remakeOctree() {
-    if (s_octree) {
-        s_octree->clear();
+    if (s_broadphase) {
+        s_broadphase->clear();
         for (BounderComponent * bounder : s_bounderComponents) {
-            s_octree->set(bounder, bounder->enclosingAABox());
+            if (!bounder->m_isInStatics) {
+                s_broadphase->set(bounder, bounder->enclosingAABox());
+            }
+        }
+    }
+}
+
+void CollisionSystem::buildStatics() {
+    PROFILE_ZONE("Build statics");
+    Vector<std::pair<const BounderComponent *, AABox>> statics;
+    for (BounderComponent * bounder : s_bounderComponents) {
+        if (bounder->m_isInStatics) {
+            statics.emplace_back(bounder, bounder->enclosingAABox());
         }
     }
+    s_statics->build(statics);
+    s_staticsChanged = false;
 }
 
 namespace {
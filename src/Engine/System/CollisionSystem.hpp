@@ -12,8 +12,13 @@
 
 class Scene;
 class BounderComponent;
+class SpatialComponent;
+class GroundComponent;
+class NewtonianComponent;
 class BounderShader;
+template <typename T> class Broadphase;
 template <typename T> class Octree;
+template <typename T> class BVH;
 class OctreeShader;
 class Mesh;
 class GameObject;
@@ -29,10 +34,19 @@ class CollisionSystem {
 
     public:
 
+    // includes what receivers of collision messages write
+    using Reads = ComponentTypes<>;
+    using Writes = ComponentTypes<BounderComponent, SpatialComponent, GroundComponent, NewtonianComponent>;
+
     static void init();
 
     static void update(float dt);
 
+    // Rebuilds the hierarchy of static bounders if any have come or gone.
+    // Done at the start of the frame, so picks made before the update see
+    // a level's geometry as soon as it's in the scene
+    static void updateStatics();
+
     // Casts a ray and returns the first bounder hit and its intersection
     static std::pair<const BounderComponent *, Intersect> pick(const Ray & ray);
     // Only bounders which pass the conditional are considered
@@ -64,10 +78,16 @@ class CollisionSystem {
         float maxDist = std::numeric_limits<float>::infinity()
     );
 
-    static void setOctree(const glm::vec3 & min, const glm::vec3 & max, float minCellSize);
+    // Uses an octree over the given region as the broadphase, see Octree for
+    // looseness
+    static void setOctree(const glm::vec3 & min, const glm::vec3 & max, float minCellSize, float looseness = 1.0f);
+    // Uses sweep and prune as the broadphase, which has no bounds
+    static void setSweepAndPrune();
 
     static void remakeOctree();
 
+    static const Broadphase<const BounderComponent *> * broadphase() { return s_broadphase.get(); }
+
     // chooses the bounder with the smallest volume from the vertex data of the given mesh
     // optionally enable/disable certain types of bounders. If all are false you are
     // dumb and it acts as if all were true
@@ -83,11 +103,22 @@ class CollisionSystem {
 
     private:
 
+    // Wakes any sleeping newtonians whose bounders are near the given one
+    static void wakeAround(const BounderComponent & bounder);
+
+    // Rebuilds the hierarchy of static bounders
+    static void buildStatics();
+
     static const Vector<BounderComponent *> & s_bounderComponents;
     static UnorderedSet<BounderComponent *> s_potentials;
     static UnorderedSet<const BounderComponent *> s_collided;
     static UnorderedSet<const BounderComponent *> s_adjusted;
-    static UniquePtr<Octree<const BounderComponent *>> s_octree;
+    static UniquePtr<Broadphase<const BounderComponent *>> s_broadphase;
+    static Octree<const BounderComponent *> * s_octree; // the broadphase, if it's an octree
+    // Bounders of static objects, like the level, never move, so are kept out
+    // of the broadphase in a hierarchy built once when they're added
+    static UniquePtr<BVH<const BounderComponent *>> s_statics;
+    static bool s_staticsChanged;
 
     public:
 
@@ -10,4 +10,20 @@ float GameInterface::getAmbience() {
 
 GameObject & GameInterface::getPlayer() {
     return *GameSystem::Player::gameObject;
+}
+
+void GameInterface::spawnEnemy(const glm::vec3 & position) {
+    GameSystem::Enemies::Basic::create(position, GameSystem::Enemies::Basic::k_moveSpeed, GameSystem::Enemies::Basic::k_maxHP);
+}
+
+glm::vec3 GameInterface::randomSpawnPoint() {
+    return GameSystem::Wave::randomSpawnPoint();
+}
+
+void GameInterface::fireProjectile(const glm::vec3 & position, const glm::vec3 & direction) {
+    GameSystem::Weapons::PizzaSlice::fire(position, direction, glm::vec3(), glm::quat());
+}
+
+void GameInterface::restorePlayer() {
+    GameSystem::Player::restore();
 }
\ No newline at end of file
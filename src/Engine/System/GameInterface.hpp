@@ -7,6 +7,10 @@
 
 
 
+#include "glm/glm.hpp"
+
+
+
 class GameObject;
 
 
@@ -17,4 +21,14 @@ struct GameInterface {
 
     static GameObject & getPlayer();
 
+    // Drive the game without anyone playing it, e.g. for benchmarking
+
+    static void spawnEnemy(const glm::vec3 & position);
+
+    static glm::vec3 randomSpawnPoint();
+
+    static void fireProjectile(const glm::vec3 & position, const glm::vec3 & direction);
+
+    static void restorePlayer();
+
 };
\ No newline at end of file
@@ -3,10 +3,12 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "Scene/Scene.hpp"
+#include "Scene/Scheduler.hpp"
 #include "Systems.hpp"
 #include "Shaders/Shaders.hpp"
 #include "Loader/Loader.hpp"
 #include "Util/Util.hpp"
+#include "Util/Profiler.hpp"
 #include "IO/Window.hpp"
 #include "EngineApp/EngineApp.hpp"
 
@@ -164,12 +166,8 @@ void GameSystem::Enemies::enablePathfinding() {
 }
 
 void GameSystem::Enemies::disablePathfinding() {
-    for (EnemyComponent * comp : s_enemyComponents) {
-        GameObject & enemy(comp->gameObject());
-        PathfindingComponent * path(enemy.getComponentByType<PathfindingComponent>());
-        if (path) {
-            Scene::removeComponent(*path);
-        }
+    for (auto enemy : Scene::view<EnemyComponent, PathfindingComponent>()) {
+        Scene::removeComponent(enemy.get<PathfindingComponent>());
     }
 }
 
@@ -520,8 +518,7 @@ void GameSystem::Shops::American::init() {
     spatial = &Scene::addComponent<SpatialComponent>(obj, glm::vec3(-37.0f, 0.5f, -79.5f), glm::vec3(1.0f), glm::mat3(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0)));
     bounder = &Scene::addComponentAs<AABBounderComponent, BounderComponent>(obj, 0, AABox(glm::vec3(-6.0f, -1.5f, -1.0f), glm::vec3(6.0f, 1.5f, 1.0f)));
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         if (&msg.bounder1 == bounder && &msg.bounder2 == static_cast<const BounderComponent *>(Player::bounder)) {
             s_shopVisited = Culture::american;
         }
@@ -556,8 +553,7 @@ void GameSystem::Shops::Asian::init() {
     spatial = &Scene::addComponent<SpatialComponent>(obj, glm::vec3(-13.0f, -0.5f, -166.0f), glm::vec3(1.0f), glm::mat3(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0)));
     bounder = &Scene::addComponentAs<AABBounderComponent, BounderComponent>(obj, 0, AABox(glm::vec3(-6.0f, -1.5f, -1.0f), glm::vec3(6.0f, 1.5f, 1.0f)));
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         if (&msg.bounder1 == bounder && &msg.bounder2 == static_cast<const BounderComponent *>(Player::bounder)) {
             s_shopVisited = Culture::asian;
         }
@@ -592,8 +588,7 @@ void GameSystem::Shops::Italian::init() {
     spatial = &Scene::addComponent<SpatialComponent>(obj, glm::vec3(39.0f, -0.5f, -40.0f), glm::vec3(1.0f), glm::mat3(glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0)));
     bounder = &Scene::addComponentAs<AABBounderComponent, BounderComponent>(obj, 0, AABox(glm::vec3(-6.0f, -1.5f, -1.0f), glm::vec3(6.0f, 1.5f, 1.0f)));
 
-    auto collisionCallback([&](const Message & msg_) {
-        const CollisionMessage & msg(static_cast<const CollisionMessage &>(msg_));
+    auto collisionCallback([&](const CollisionMessage & msg) {
         if (&msg.bounder1 == bounder && &msg.bounder2 == static_cast<const BounderComponent *>(Player::bounder)) {
             s_shopVisited = Culture::italian;
         }
@@ -760,10 +755,6 @@ void GameSystem::Music::set() {
 //==============================================================================
 // Game System
 
-const Vector<CameraComponent *> & GameSystem::s_cameraComponents(Scene::getComponents<CameraComponent>());
-const Vector<CameraControllerComponent *> & GameSystem::s_cameraControllerComponents(Scene::getComponents<CameraControllerComponent>());
-const Vector<PlayerControllerComponent *> & GameSystem::s_playerControllers(Scene::getComponents<PlayerControllerComponent>());
-const Vector<PlayerComponent *> & GameSystem::s_playerComponents(Scene::getComponents<PlayerComponent>());
 const Vector<EnemyComponent *> & GameSystem::s_enemyComponents(Scene::getComponents<EnemyComponent>());
 const Vector<ProjectileComponent *> & GameSystem::s_projectileComponents(Scene::getComponents<ProjectileComponent>());
 const Vector<BlastComponent *> & GameSystem::s_blastComponents(Scene::getComponents<BlastComponent>());
@@ -836,35 +827,19 @@ void GameSystem::init() {
 
 void GameSystem::update(float dt) {
     // Update controllers (must be before game logic)
-    for (auto & comp : s_playerControllers) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_cameraControllerComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<PlayerControllerComponent>(dt);
+    Scene::updateComponents<CameraControllerComponent>(dt);
 
     // Game Logic
     updateGame(dt);
 
     // Update components
-    for (auto & comp : s_cameraComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_playerComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_enemyComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_projectileComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_blastComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_meleeComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<CameraComponent>(dt);
+    Scene::updateComponents<PlayerComponent>(dt);
+    Scene::updateComponents<EnemyComponent, BasicEnemyComponent>(dt);
+    Scene::updateComponents<ProjectileComponent, BulletComponent, GrenadeComponent>(dt);
+    Scene::updateComponents<BlastComponent>(dt);
+    Scene::updateComponents<MeleeComponent, SprayComponent>(dt);
 }
 
 void GameSystem::updateGame(float dt) {
@@ -872,11 +847,15 @@ void GameSystem::updateGame(float dt) {
     if (s_inPurgatory) {
         // Still in purgatory
         if ((s_purgatoryCooldown -= dt) > 0.0f) {
+#ifndef HEADLESS_MODE
             RenderSystem::s_postProcessShader->setScreenTone(glm::vec3(s_purgatoryCooldown / k_purgatoryTime));
+#endif
             return;
         }
         // Out of purgatory, lets go
+#ifndef HEADLESS_MODE
         RenderSystem::s_postProcessShader->setScreenTone(glm::vec3(1.0f));
+#endif
         startGame();
         return;
     }
@@ -1014,8 +993,7 @@ void GameSystem::endWave() {
 
 void GameSystem::setupMessageCallbacks() {
     // Use weapon (click)
-    auto useWeaponCallback([&](const Message & msg_) {
-        const MouseMessage & msg(static_cast<const MouseMessage &>(msg_));
+    auto useWeaponCallback([&](const MouseMessage & msg) {
         if (msg.button == GLFW_MOUSE_BUTTON_1 && !(msg.mods & GLFW_MOD_CONTROL)) {
             if (msg.action == GLFW_PRESS) {
                 s_useWeapon = true;                
@@ -1028,14 +1006,13 @@ void GameSystem::setupMessageCallbacks() {
     Scene::addReceiver<MouseMessage>(nullptr, useWeaponCallback);
 
     // Player death
-    auto playerDeathCallback([&](const Message & msg_) {
+    auto playerDeathCallback([&](const PlayerDeathMessage &) {
         if (!s_inPurgatory) s_playerDied = true;
     });
     Scene::addReceiver<PlayerDeathMessage>(nullptr, playerDeathCallback);
     
     // Set culture (1 | 2 | 3 | 4)
-    auto setCultureCallback([&](const Message & msg_) {
-        const KeyMessage & msg(static_cast<const KeyMessage &>(msg_));
+    auto setCultureCallback([&](const KeyMessage & msg) {
         if (msg.action != GLFW_PRESS || msg.mods) {
             return;
         }
@@ -1049,8 +1026,7 @@ void GameSystem::setupMessageCallbacks() {
     Scene::addReceiver<KeyMessage>(nullptr, setCultureCallback);
 
     // Game Controls
-    auto gameControlsCallback([&](const Message & msg_) {
-        const KeyMessage & msg(static_cast<const KeyMessage &>(msg_));
+    auto gameControlsCallback([&](const KeyMessage & msg) {
         if (msg.action != GLFW_PRESS) {
             return;
         }
@@ -1076,11 +1052,10 @@ void GameSystem::setupMessageCallbacks() {
     Scene::addReceiver<KeyMessage>(nullptr, gameControlsCallback);
 
     // Shoot ray (ctrl-click)
-    auto rayPickCallback([&](const Message & msg_) {
+    auto rayPickCallback([&](const MouseMessage & msg) {
         static const int rayDepth(100);
         static Vector<glm::vec3> rayPositions;
 
-        const MouseMessage & msg(static_cast<const MouseMessage &>(msg_));
         if (msg.button == GLFW_MOUSE_BUTTON_1 && msg.mods & GLFW_MOD_CONTROL && msg.action == GLFW_PRESS) {
             rayPositions.clear();
             rayPositions.push_back(Player::headSpatial->position());
@@ -1093,16 +1068,17 @@ void GameSystem::setupMessageCallbacks() {
                 rayPositions.push_back(pair.second.pos);
                 dir = glm::normalize(glm::reflect(dir, pair.second.face ? pair.second.norm : -pair.second.norm));
             }
+#ifndef HEADLESS_MODE
             RenderSystem::s_rayShader->setPositions(rayPositions);
+#endif
         }
     });
     Scene::addReceiver<MouseMessage>(nullptr, rayPickCallback);
 
     // Toggle Freecam (ctrl-tab)
-    auto camSwitchCallback([&](const Message & msg_) {
+    auto camSwitchCallback([&](const KeyMessage & msg) {
         static bool free = false;
 
-        const KeyMessage & msg(static_cast<const KeyMessage &>(msg_));
         if (msg.key == GLFW_KEY_TAB && msg.action == GLFW_PRESS && msg.mods & GLFW_MOD_CONTROL) {
             if (free) {
                 // disable camera controller
@@ -1127,10 +1103,9 @@ void GameSystem::setupMessageCallbacks() {
     Scene::addReceiver<KeyMessage>(nullptr, camSwitchCallback);
 
     // Toggle gravity (ctrl-g), flip gravity (alt-g)
-    auto gravCallback([&](const Message & msg_) {
+    auto gravCallback([&](const KeyMessage & msg) {
         static glm::vec3 s_gravity = k_defGravity;
 
-        const KeyMessage & msg(static_cast<const KeyMessage &>(msg_));
         if (msg.key == GLFW_KEY_G && msg.action == GLFW_PRESS && msg.mods == GLFW_MOD_CONTROL) {
             if (Util::isZero(SpatialSystem::gravity())) {
                 SpatialSystem::setGravity(s_gravity);
@@ -1148,9 +1123,7 @@ void GameSystem::setupMessageCallbacks() {
     Scene::addReceiver<KeyMessage>(nullptr, gravCallback);
 
     // Toggle background music (m)
-    auto musicCallback([&](const Message & msg_) {
-        const KeyMessage & msg(static_cast<const KeyMessage &>(msg_));
-
+    auto musicCallback([&](const KeyMessage & msg) {
         if (msg.key == GLFW_KEY_M && !msg.mods && msg.action == GLFW_PRESS) {
             Music::toggle();
         }
@@ -1192,14 +1165,9 @@ void GameSystem::setupImGui() {
             ImGui::Text("Workload by System (Update, Messaging)");
             float factor(100.0f / Scene::totalDT);
             ImGui::Text("    Init Queue: %5.2f%%", Scene::initDT * factor);
-            ImGui::Text("          Game: %5.2f%%, %5.2f%%", Scene::         gameDT * factor, Scene::         gameMessagingDT * factor);
-            ImGui::Text("   Pathfinding: %5.2f%%, %5.2f%%", Scene::  pathfindingDT * factor, Scene::  pathfindingMessagingDT * factor);
-            ImGui::Text("       Spatial: %5.2f%%, %5.2f%%", Scene::      spatialDT * factor, Scene::      spatialMessagingDT * factor);
-            ImGui::Text("     Collision: %5.2f%%, %5.2f%%", Scene::    collisionDT * factor, Scene::    collisionMessagingDT * factor);
-            ImGui::Text("Post Collision: %5.2f%%, %5.2f%%", Scene::postCollisionDT * factor, Scene::postCollisionMessagingDT * factor);
-            ImGui::Text("      Particle: %5.2f%%, %5.2f%%", Scene::     particleDT * factor, Scene::              particleDT * factor);
-            ImGui::Text("        Render: %5.2f%%, %5.2f%%", Scene::       renderDT * factor, Scene::       renderMessagingDT * factor);
-            ImGui::Text("         Sound: %5.2f%%, %5.2f%%", Scene::        soundDT * factor, Scene::        soundMessagingDT * factor);
+            for (const Scheduler::Task & task : Scheduler::tasks()) {
+                ImGui::Text("%14s: %5.2f%%, %5.2f%%", task.name.c_str(), task.updateDT * factor, task.messagingDT * factor);
+            }
             ImGui::Text("    Kill Queue: %5.2f%%", Scene::killDT * factor);
             ImGui::NewLine();
             ImGui::Text("# Picks: %d", CollisionSystem::s_nPicks);
@@ -1232,6 +1200,71 @@ void GameSystem::setupImGui() {
        }
     );
 
+    // Profiler
+    Scene::addComponent<ImGuiComponent>(
+        imguiGO,
+        "Profiler",
+        [&]() {
+            static int s_traceFrames(60);
+            bool enabled(Profiler::isEnabled());
+            if (ImGui::Checkbox("Enabled", &enabled)) {
+                Profiler::setEnabled(enabled);
+            }
+            ImGui::SliderInt("Frames", &s_traceFrames, 1, 600);
+            /* Written to the working directory, open in chrome://tracing */
+            if (ImGui::Button("Save Trace")) {
+                Profiler::writeChromeTrace("profile.json", s_traceFrames);
+            }
+        }
+    );
+
+    // Memory
+    Scene::addComponent<ImGuiComponent>(
+        imguiGO,
+        "Memory",
+        [&]() {
+#ifndef TRACK_MEMORY
+            ImGui::Text("Configure with -DTRACK_MEMORY=ON to count allocations");
+#endif
+            /* Written to the working directory, a row per frame */
+            if (ImGui::Button(MemoryStats::isWritingCSV() ? "Stop CSV" : "Record CSV")) {
+                if (MemoryStats::isWritingCSV()) {
+                    MemoryStats::closeCSV();
+                }
+                else {
+                    MemoryStats::openCSV("memory.csv");
+                }
+            }
+            ImGui::Text("%10s %10s %10s %10s %10s", "", "Live KB", "Peak KB", "Allocs", "Alloc KB");
+            for (int c(0); c < MemoryStats::k_nCategories; ++c) {
+                const MemoryStats::Counters & counters(MemoryStats::total(MemoryCategory(c)));
+                ImGui::Text("%10s %10.1f %10.1f %10lld %10.1f",
+                    MemoryStats::name(MemoryCategory(c)),
+                    double(counters.liveBytes) / 1024.0,
+                    double(counters.peakBytes) / 1024.0,
+                    (long long)(counters.frameAllocations),
+                    double(counters.frameBytes) / 1024.0
+                );
+            }
+            for (int t(0); t < MemoryStats::threadCount(); ++t) {
+                if (!ImGui::TreeNode(&MemoryStats::thread(t, MemoryCategory::General), "Thread %d", t)) {
+                    continue;
+                }
+                for (int c(0); c < MemoryStats::k_nCategories; ++c) {
+                    const MemoryStats::Counters & counters(MemoryStats::thread(t, MemoryCategory(c)));
+                    ImGui::Text("%10s %10.1f %10.1f %10lld %10.1f",
+                        MemoryStats::name(MemoryCategory(c)),
+                        double(counters.liveBytes) / 1024.0,
+                        double(counters.peakBytes) / 1024.0,
+                        (long long)(counters.frameAllocations),
+                        double(counters.frameBytes) / 1024.0
+                    );
+                }
+                ImGui::TreePop();
+            }
+        }
+    );
+
     // Misc
     Scene::addComponent<ImGuiComponent>(
         imguiGO,
@@ -22,6 +22,9 @@ class GameSystem {
 
     public:
 
+    using Reads = ComponentTypes<>;
+    using Writes = AllComponents;
+
     enum class Culture { none, american, asian, italian };
 
     private:
@@ -344,11 +347,7 @@ class GameSystem {
 
     private:
 
-    static const Vector<CameraComponent *> & s_cameraComponents;
-    static const Vector<CameraControllerComponent *> & s_cameraControllerComponents;
-    static const Vector<PlayerControllerComponent *> & s_playerControllers;
     static const Vector<ImGuiComponent *> & s_imguiComponents;
-    static const Vector<PlayerComponent *> & s_playerComponents;
     static const Vector<EnemyComponent *> & s_enemyComponents;
     static const Vector<ProjectileComponent *> & s_projectileComponents;
     static const Vector<BlastComponent *> & s_blastComponents;
@@ -2,10 +2,6 @@
 
 #include "Scene/Scene.hpp"
 
-const Vector<MapExploreComponent *> & MapExploreSystem::s_mapexploreComponents(Scene::getComponents<MapExploreComponent>());
-
 void MapExploreSystem::update(float dt) {
-    for (auto & comp : s_mapexploreComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<MapExploreComponent>(dt);
 }
\ No newline at end of file
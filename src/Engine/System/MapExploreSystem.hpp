@@ -2,6 +2,10 @@
 
 #include "System.hpp"
 #include "Component/MapExploreComponents/MapExploreComponent.hpp"
+
+class SpatialComponent;
+class BounderComponent;
+
 // static class
 class MapExploreSystem {
 
@@ -9,12 +13,11 @@ class MapExploreSystem {
     
     public:
 
+    using Reads = ComponentTypes<BounderComponent>;
+    using Writes = ComponentTypes<MapExploreComponent, SpatialComponent>;
+
     static void init() {}
 
     static void update(float dt);
 
-    private:
-
-    static const Vector<MapExploreComponent *> & s_mapexploreComponents;
-
 };
\ No newline at end of file
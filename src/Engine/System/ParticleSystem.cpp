@@ -5,7 +5,6 @@
 
 #include "Scene/Scene.hpp"
 #include "Component/ParticleComponents/ParticleComponent.hpp"
-#include "Component/ParticleComponents/ParticleAssasinComponent.hpp"
 #include "Loader/Loader.hpp"
 #include "Component/SpatialComponents/SpatialComponent.hpp"
 #include "Util/Util.hpp"
@@ -18,7 +17,6 @@ const float ParticleSystem::k_minScaleFactor = 0.5f;
 const float ParticleSystem::k_maxScaleFactor = 1.5f;
 
 const Vector<ParticleComponent *> & ParticleSystem::s_particleComponents(Scene::getComponents<ParticleComponent>());
-const Vector<ParticleAssasinComponent *> & ParticleSystem::s_particleAssasinComponents(Scene::getComponents<ParticleAssasinComponent>());
 Vector<glm::mat4> ParticleSystem::s_variationMs = Vector<glm::mat4>(k_maxVariations);
 Vector<glm::mat3> ParticleSystem::s_variationNs = Vector<glm::mat3>(k_maxVariations);
 
@@ -34,12 +32,8 @@ void ParticleSystem::init() {
 }
 
 void ParticleSystem::update(float dt) {
-    for (ParticleComponent * comp : s_particleComponents) {
-        comp->update(dt);
-    }
-    for (ParticleAssasinComponent * comp : s_particleAssasinComponents) {
-        comp->update(dt);
-    }
+    MemoryScope memoryScope(MemoryCategory::Particles);
+    Scene::updateComponents<ParticleComponent>(dt);
 }
 
 ParticleComponent & ParticleSystem::addBodyExplosionPC(SpatialComponent & spatial) {   
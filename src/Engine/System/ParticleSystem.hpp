@@ -4,6 +4,7 @@
 
 #include "glm/glm.hpp"
 
+#include "System.hpp"
 #include "Util/Memory.hpp"
 
 
@@ -12,7 +13,6 @@ class ParticleComponent;
 class Scene;
 class GameObject;
 class SpatialComponent;
-class ParticleAssasinComponent;
 class DiffuseShader;
 class ShadowDepthShader;
 
@@ -26,6 +26,10 @@ class ParticleSystem {
 
     public:
 
+        // reads anchor transforms, which may fill in their cached matrices
+        using Reads = ComponentTypes<>;
+        using Writes = ComponentTypes<ParticleComponent, SpatialComponent>;
+
         static void init();
         static void update(float dt);
     
@@ -46,7 +50,6 @@ class ParticleSystem {
     private:
 
         static const Vector<ParticleComponent *> & s_particleComponents;
-        static const Vector<ParticleAssasinComponent *> & s_particleAssasinComponents;
         static Vector<glm::mat4> s_variationMs;
         static Vector<glm::mat3> s_variationNs;
 
@@ -8,8 +8,6 @@
 // Init graph
 PathfindingSystem::vecvectorMap PathfindingSystem::graph = PathfindingSystem::vecvectorMap();
 
-const Vector<PathfindingComponent *> & PathfindingSystem::s_pathfindingComponents(Scene::getComponents<PathfindingComponent>());
-
 void PathfindingSystem::init() {
 
     // Read in the graph of the map from a text file
@@ -17,9 +15,7 @@ void PathfindingSystem::init() {
 }
 
 void PathfindingSystem::update(float dt) {
-    for (auto & comp : s_pathfindingComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<PathfindingComponent>(dt);
 }
 
 // Read in the graph from a specified file and fill out the vecToNode map
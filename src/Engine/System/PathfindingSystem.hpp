@@ -7,6 +7,8 @@
 
 class Scene;
 class PathfindingComponent;
+class SpatialComponent;
+class BounderComponent;
 
 
 // static class
@@ -37,14 +39,18 @@ public:
 	    }
 	};
 
-	typedef std::unordered_map<glm::vec3, glm::vec3, vecHash, gridCompare> vecvecMap;
-	typedef std::unordered_map<glm::vec3, double, vecHash, gridCompare> vecdoubleMap;
+	// search state, which only lasts the frame
+	typedef FrameUnorderedMap<glm::vec3, glm::vec3, vecHash, gridCompare> vecvecMap;
+	typedef FrameUnorderedMap<glm::vec3, double, vecHash, gridCompare> vecdoubleMap;
 	typedef std::unordered_map<glm::vec3, Vector<glm::vec3>, vecHash, gridCompare> vecvectorMap;
 
     friend Scene;
     
     public:
 
+    using Reads = ComponentTypes<BounderComponent>;
+    using Writes = ComponentTypes<PathfindingComponent, SpatialComponent>;
+
     static void init();
 
     static void update(float dt);
@@ -53,8 +59,6 @@ public:
 
     private:
 
-    static const Vector<PathfindingComponent *> & s_pathfindingComponents;
-
     static void readInGraph(String, vecvectorMap &);
 
 };
\ No newline at end of file
@@ -5,10 +5,6 @@
 
 
 
-const Vector<GroundComponent *> & PostCollisionSystem::s_groundComponents(Scene::getComponents<GroundComponent>());
-
 void PostCollisionSystem::update(float dt) {
-    for (auto & comp : s_groundComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<GroundComponent>(dt);
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 class Scene;
 class GroundComponent;
+class NewtonianComponent;
 
 
 
@@ -21,12 +22,11 @@ class PostCollisionSystem {
 
     public:
 
+    using Reads = ComponentTypes<NewtonianComponent>; // whether they're asleep
+    using Writes = ComponentTypes<GroundComponent>;
+
     static void init() {};
 
     static void update(float dt);
 
-    private:
-
-    static const Vector<GroundComponent *> & s_groundComponents;
-
 };
\ No newline at end of file
@@ -16,12 +16,14 @@
 #endif
 
 const Vector<DiffuseRenderComponent *> & RenderSystem::s_diffuseComponents(Scene::getComponents<DiffuseRenderComponent>());
+#ifndef HEADLESS_MODE
 /* FBO */
 GLuint RenderSystem::s_fbo = 0;
 GLuint RenderSystem::s_fboColorTexs[2];
 GLuint RenderSystem::s_pingpongFBO[2];
 GLuint RenderSystem::s_pingpongColorbuffers[2];
 bool RenderSystem::s_wasResize = false;
+#endif
 /* Camera and light */
 const CameraComponent * RenderSystem::s_playerCamera = nullptr;
 GameObject * RenderSystem::s_lightObject = nullptr;
@@ -33,6 +35,7 @@ float RenderSystem::shadowAmbience(0.0f);
 float RenderSystem::transitionDistance(50.f);
 int RenderSystem::pcfCount(0);
 
+#ifndef HEADLESS_MODE
 /* Shaders */
 UniquePtr<ShadowDepthShader> RenderSystem::s_shadowShader;;
 UniquePtr<DiffuseShader> RenderSystem::s_diffuseShader;
@@ -42,9 +45,11 @@ UniquePtr<OctreeShader> RenderSystem::s_octreeShader;
 UniquePtr<PostProcessShader> RenderSystem::s_postProcessShader;
 UniquePtr<BlurShader> RenderSystem::s_blurShader;
 UniquePtr<HealthShader> RenderSystem::s_healthShader;
+#endif
  
 
 void RenderSystem::init() {
+#ifndef HEADLESS_MODE
     /* Init GL state */
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
@@ -55,11 +60,11 @@ void RenderSystem::init() {
 
     /* Init GL window */
     glViewport(0, 0, Window::getFrameSize().x, Window::getFrameSize().y);
-    auto sizeCallback([&](const Message & msg_) {
-        const WindowFrameSizeMessage & msg(static_cast<const WindowFrameSizeMessage &>(msg_));
+    auto sizeCallback([&](const WindowFrameSizeMessage & msg) {
         s_wasResize = true;
     });
     Scene::addReceiver<WindowFrameSizeMessage>(nullptr, sizeCallback);
+#endif
 
     /* Init light */
     s_lightObject = &Scene::createGameObject();
@@ -71,6 +76,7 @@ void RenderSystem::init() {
     s_lightCamera = &Scene::addComponent<CameraComponent>(*s_lightObject, glm::vec2(-115.f, 118.f), glm::vec2(-42.f, 234.f), -40.f, 156.f);
     //Scene::addComponent<DiffuseRenderComponent>(*s_lightObject, *s_lightSpatial, *Loader::getMesh("cube.obj"), ModelTexture(Material(glm::vec3(1.f, 0.f, 0.f), glm::vec3(0.f, 0.f, 1.f), 16.f)), true, glm::vec2(1, 1));
 
+#ifndef HEADLESS_MODE
     /* Init shaders */
     if (!(    s_diffuseShader = UniquePtr<    DiffuseShader>::make(    "diffuse_vert.glsl",     "diffuse_frag.glsl")) ||
         !(    s_bounderShader = UniquePtr<    BounderShader>::make(    "bounder_vert.glsl",     "bounder_frag.glsl")) ||
@@ -100,20 +106,22 @@ void RenderSystem::init() {
 
     /* Init FBO */
     initFBO();
+#endif
 }
 
 void RenderSystem::update(float dt) {
+#ifndef HEADLESS_MODE
     /* Handle window resize */
     if (s_wasResize) {
         doResize();
         s_wasResize = false;
     }
+#endif
 
     /* Update render components */
-    for (DiffuseRenderComponent * comp : s_diffuseComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<DiffuseRenderComponent>(dt);
 
+#ifndef HEADLESS_MODE
     if (!s_playerCamera) {
         return;
     }
@@ -154,6 +162,7 @@ void RenderSystem::update(float dt) {
     
     /* Update light -- done here to sync with other game logic */
     //updateLightCamera();
+#endif
 }
 void RenderSystem::setCamera(const CameraComponent * camera) {
     s_playerCamera = camera;
@@ -173,6 +182,7 @@ void RenderSystem::setLightDir(glm::vec3 in) {
     }
 }
 
+#ifndef HEADLESS_MODE
 void RenderSystem::initFBO() {
     // Initialize framebuffer to draw into
     glGenFramebuffers(1, &s_fbo);
@@ -236,9 +246,10 @@ void RenderSystem::doResize() {
     glViewport(0, 0, Window::getFrameSize().x, Window::getFrameSize().y);
     initFBO();
 }
+#endif
 
 /* Frustum culling */
-void RenderSystem::getFrustumComps(const CameraComponent *camera, Vector<DiffuseRenderComponent *> &comps) {
+void RenderSystem::getFrustumComps(const CameraComponent *camera, FrameVector<DiffuseRenderComponent *> &comps) {
     for (auto comp : s_diffuseComponents) {
         if (camera->sphereInFrustum(comp->enclosingSphere())) {
             comps.push_back(comp);
@@ -246,6 +257,7 @@ void RenderSystem::getFrustumComps(const CameraComponent *camera, Vector<Diffuse
     }
 }
 
+#ifndef HEADLESS_MODE
 void RenderSystem::doBloom() {
     //Blur bright frags
     bool horizontal = true, first_iteration = true;
@@ -268,6 +280,7 @@ void RenderSystem::doBloom() {
     }
     s_blurShader->unbind();
 }
+#endif
 
 void RenderSystem::updateLightCamera() {
     /* Size of player cam's near and far plane - far plane adjusted to shadow distance */
@@ -287,7 +300,7 @@ void RenderSystem::updateLightCamera() {
     glm::vec3 centerFar = camPos + (forward * lightDist);
 
     /* Calculate 8 points of player's frustum in light space */
-    Vector<glm::vec4> corners;
+    FrameVector<glm::vec4> corners;
     calculateFrustumVertices(corners, centerNear, centerFar, nearSize, farSize);
 
     /* Find AABB of player cam's projection in light space */
@@ -319,7 +332,7 @@ void RenderSystem::updateLightCamera() {
 }
 
 // TODO : move this to camera component?
-void RenderSystem::calculateFrustumVertices(Vector<glm::vec4> & points, glm::vec3 centerNear, glm::vec3 centerFar, glm::vec2 nearSize, glm::vec2 farSize) {
+void RenderSystem::calculateFrustumVertices(FrameVector<glm::vec4> & points, glm::vec3 centerNear, glm::vec3 centerFar, glm::vec2 nearSize, glm::vec2 farSize) {
     glm::vec3 upVector = glm::normalize(s_playerCamera->spatial().v());
     glm::vec3 rightVector = glm::normalize(s_playerCamera->spatial().u());
     glm::vec3 farTop = centerFar + (upVector * farSize.y);
@@ -10,6 +10,7 @@
 
 #include "System.hpp"
 
+#ifndef HEADLESS_MODE
 #include "Shaders/DiffuseShader.hpp"
 #include "Shaders/BounderShader.hpp"
 #include "Shaders/OctreeShader.hpp"
@@ -18,10 +19,15 @@
 #include "Shaders/ShadowDepthShader.hpp"
 #include "Shaders/BlurShader.hpp"
 #include "Shaders/HealthShader.hpp"
+#endif
 
 
 
 class DiffuseRenderComponent;
+class SpatialComponent;
+class CameraComponent;
+class ParticleComponent;
+class BounderComponent;
 
 
 
@@ -32,6 +38,10 @@ class RenderSystem {
 
 public:
 
+    // needs the GL context, so is always updated on the main thread
+    using Reads = ComponentTypes<DiffuseRenderComponent, CameraComponent, ParticleComponent, BounderComponent>;
+    using Writes = ComponentTypes<SpatialComponent>; // cached matrices
+
     static void init();
 
     /* Full render function including shadow maps, main render calls, and post-processing */
@@ -53,6 +63,9 @@ public:
     static float transitionDistance;
     static int pcfCount;
 
+    // In a headless build there is nothing to render to, so there are no
+    // shaders or framebuffers, and only the render components are updated
+#ifndef HEADLESS_MODE
     /* Shadows */
     static const glm::mat4 & getL() { return s_shadowShader->getL(); }
     static const Texture * getShadowMap() { return s_shadowShader->getShadowMapTexture(); }
@@ -70,8 +83,9 @@ public:
     /* FBO Stuff */
     static GLuint getFBOTexture() { return s_fboColorTexs[0]; }
     static GLuint getBloomTexture() { return s_pingpongColorbuffers[0]; }
+#endif
 
-    static void getFrustumComps(const CameraComponent *, Vector<DiffuseRenderComponent *> &);
+    static void getFrustumComps(const CameraComponent *, FrameVector<DiffuseRenderComponent *> &);
 
 private:
 
@@ -79,6 +93,7 @@ private:
 
     static const Vector<DiffuseRenderComponent *> & s_diffuseComponents;
 
+#ifndef HEADLESS_MODE
     static void initFBO();
     static void doResize();
     static GLuint s_fbo;
@@ -86,9 +101,10 @@ private:
     static GLuint s_pingpongFBO[2];
     static GLuint s_pingpongColorbuffers[2];
     static bool s_wasResize;
+#endif
 
     static void updateLightCamera();
-    static void calculateFrustumVertices(Vector<glm::vec4> &, glm::vec3, glm::vec3, glm::vec2, glm::vec2);
+    static void calculateFrustumVertices(FrameVector<glm::vec4> &, glm::vec3, glm::vec3, glm::vec2, glm::vec2);
     static glm::vec4 calculateLightSpaceFrustumCorner(glm::vec3, glm::vec3, float);
 };
 
@@ -41,6 +41,10 @@ class SoundSystem {
     #endif
 
     public:
+        // reads the listener's transform, which may fill in its cached matrices
+        using Reads = ComponentTypes<>;
+        using Writes = ComponentTypes<SpatialComponent>;
+
         static void init();
         static void update(float dt);
 
@@ -1,5 +1,7 @@
 #include "SpatialSystem.hpp"
 
+#include <limits>
+
 #include "Scene/Scene.hpp"
 #include "Component/SpatialComponents/SpatialComponent.hpp"
 #include "Component/SpatialComponents/PhysicsComponents.hpp"
@@ -11,28 +13,29 @@ const float SpatialSystem::k_terminalVelocity = 50.0f;
 const float SpatialSystem::k_coefficientOfFriction = 0.5f;
 const float SpatialSystem::k_elasticity = 2.0f / 3.0f;
 const float SpatialSystem::k_bounceVelThreshold = 0.5f;
+const float SpatialSystem::k_sleepSpeed = 0.05f;
+const int SpatialSystem::k_sleepFrames = 10;
 
 const Vector<SpatialComponent *> & SpatialSystem::s_spatialComponents(Scene::getComponents<SpatialComponent>());
-const Vector<NewtonianComponent *> & SpatialSystem::s_newtonianComponents(Scene::getComponents<NewtonianComponent>());
-const Vector<AcceleratorComponent *> & SpatialSystem::s_acceleratorComponents(Scene::getComponents<AcceleratorComponent>());
-const Vector<AnimationComponent *> & SpatialSystem::s_animationComponents(Scene::getComponents<AnimationComponent>());
 glm::vec3 SpatialSystem::s_gravityDir = glm::vec3(0.0f, 0.0f, 0.0f);
 float SpatialSystem::s_gravityMag = 0.0f;
+bool SpatialSystem::s_sleepEnabled = true;
+Vector<const SpatialComponent *> SpatialSystem::s_changed;
+std::mutex SpatialSystem::s_changedMutex;
+Vector<const SpatialComponent *> SpatialSystem::s_published;
+Vector<const SpatialComponent *> SpatialSystem::s_moved;
+float SpatialSystem::s_dt(std::numeric_limits<float>::infinity());
+Vector<const SpatialComponent *> SpatialSystem::s_hierarchy;
+std::mutex SpatialSystem::s_hierarchyMutex;
 
 void SpatialSystem::init() {
 
 }
 
 void SpatialSystem::update(float dt) {
-    for (auto & comp : s_acceleratorComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_newtonianComponents) {
-        comp->update(dt);
-    }
-    for (auto & comp : s_animationComponents) {
-        comp->update(dt);
-    }
+    Scene::updateComponents<AcceleratorComponent, GravityComponent, AcceleratorComponent>(dt);
+    NewtonianComponent::integrate(Scene::getComponentsOfType<NewtonianComponent>(), dt);
+    Scene::updateComponents<AnimationComponent, SpinAnimationComponent, ScaleToAnimationComponent>(dt);
 }
 
 void SpatialSystem::setGravity(const glm::vec3 & gravity) {
@@ -52,4 +55,107 @@ void SpatialSystem::setGravityDir(const glm::vec3 & dir) {
 
 void SpatialSystem::setGravityMag(float mag) {
     s_gravityMag = mag;
-}
\ No newline at end of file
+}
+
+void SpatialSystem::markChanged(const SpatialComponent & spatial, bool publish) {
+    std::lock_guard<std::mutex> lock(s_changedMutex);
+    if (spatial.m_movedIndex < 0) {
+        spatial.m_movedIndex = int(s_moved.size());
+        s_moved.push_back(&spatial);
+    }
+    if (publish && !spatial.m_isDirty) {
+        spatial.m_isDirty = true;
+        s_changed.push_back(&spatial);
+    }
+}
+
+void SpatialSystem::unmarkChanged(const SpatialComponent & spatial) {
+    std::lock_guard<std::mutex> lock(s_changedMutex);
+    if (spatial.m_movedIndex >= 0) {
+        s_moved[spatial.m_movedIndex] = s_moved.back();
+        s_moved[spatial.m_movedIndex]->m_movedIndex = spatial.m_movedIndex;
+        s_moved.pop_back();
+        spatial.m_movedIndex = -1;
+    }
+    if (spatial.m_isDirty) {
+        spatial.m_isDirty = false;
+        for (int i(int(s_changed.size()) - 1); i >= 0; --i) {
+            if (s_changed[i] == &spatial) {
+                s_changed.erase(s_changed.begin() + i);
+                break;
+            }
+        }
+    }
+}
+
+void SpatialSystem::addToHierarchy(const SpatialComponent & spatial) {
+    // a parent is always created before its children, so appending keeps the
+    // order
+    std::lock_guard<std::mutex> lock(s_hierarchyMutex);
+    s_hierarchy.push_back(&spatial);
+}
+
+void SpatialSystem::removeFromHierarchy(const SpatialComponent & spatial) {
+    std::lock_guard<std::mutex> lock(s_hierarchyMutex);
+    for (int i(int(s_hierarchy.size()) - 1); i >= 0; --i) {
+        if (s_hierarchy[i] == &spatial) {
+            s_hierarchy.erase(s_hierarchy.begin() + i);
+            break;
+        }
+    }
+}
+
+void SpatialSystem::replaceInHierarchy(const SpatialComponent & from, const SpatialComponent & to) {
+    std::lock_guard<std::mutex> lock(s_hierarchyMutex);
+    for (int i(int(s_hierarchy.size()) - 1); i >= 0; --i) {
+        if (s_hierarchy[i] == &from) {
+            s_hierarchy[i] = &to;
+            break;
+        }
+    }
+}
+
+void SpatialSystem::updateTransforms() {
+    // each parent is either a root, whose matrices don't depend on anything
+    // else, or came earlier in the list, so nothing recurses
+    for (const SpatialComponent * spatial : s_hierarchy) {
+        if (!spatial->m_modelMatValid) spatial->updateModelMatrix();
+        if (!spatial->m_normalMatValid) spatial->normalMatrix();
+    }
+}
+
+void SpatialSystem::rollover(float dt) {
+    s_dt = dt;
+    for (const SpatialComponent * spatial : s_moved) {
+        spatial->m_movedIndex = -1;
+        // only marked by the spatial itself, which the scene owns
+        const_cast<SpatialComponent *>(spatial)->update(dt);
+    }
+    s_moved.clear();
+}
+
+int SpatialSystem::publishChanges() {
+    // the previous SpatialChangesMessage has been relayed by now, so its list
+    // can be reused
+    s_published.clear();
+    if (s_changed.empty()) {
+        return 0;
+    }
+    updateTransforms();
+    std::swap(s_changed, s_published);
+    int n(0);
+    for (const SpatialComponent * spatial : s_published) {
+        spatial->m_isDirty = false;
+        // the game object is already gone, so no one cares
+        if (!spatial->hasGameObject()) {
+            continue;
+        }
+        Scene::sendMessage<SpatialChangeMessage>(&spatial->gameObject(), *spatial);
+        s_published[n++] = spatial;
+    }
+    s_published.resize(n);
+    if (n) {
+        Scene::sendMessage<SpatialChangesMessage>(nullptr, s_published);
+    }
+    return n;
+}
@@ -2,6 +2,8 @@
 
 
 
+#include <mutex>
+
 #include "glm/glm.hpp"
 
 #include "System.hpp"
@@ -21,9 +23,13 @@ class AnimationComponent;
 class SpatialSystem {
 
     friend Scene;
+    friend SpatialComponent;
 
     public:
 
+    using Reads = ComponentTypes<>;
+    using Writes = ComponentTypes<SpatialComponent, NewtonianComponent, AcceleratorComponent, AnimationComponent>;
+
     static void init();
 
     static void update(float dt);
@@ -32,24 +38,60 @@ class SpatialSystem {
     static void setGravityDir(const glm::vec3 & dir);
     static void setGravityMag(float mag);
 
+    // Whether resting newtonians may fall asleep. Turning it off wakes them
+    static void setSleepEnabled(bool enabled) { s_sleepEnabled = enabled; }
+    static bool isSleepEnabled() { return s_sleepEnabled; }
+
     static glm::vec3 gravity() { return s_gravityDir * s_gravityMag; }
     static const glm::vec3 & gravityDir() { return s_gravityDir; }
     static float gravityMag() { return s_gravityMag; }
 
+    private:
+
+    // Spatial changes are not sent as they happen. Instead each changed
+    // spatial is marked once, and the scene has them published at the start
+    // of every messaging pass. That way a spatial that is moved several times
+    // in one system update only sends one SpatialChangeMessage. Silent
+    // changes aren't published, but are still rolled over. Safe to call from
+    // jobs updating different spatials at the same time
+    static void markChanged(const SpatialComponent & spatial, bool publish);
+    static void unmarkChanged(const SpatialComponent & spatial);
+    // Spatials with a parent are kept in one list, each after its parent, so
+    // a single pass in order brings every changed subtree's matrices up to
+    // date without climbing back up to the parents
+    static void addToHierarchy(const SpatialComponent & spatial);
+    static void removeFromHierarchy(const SpatialComponent & spatial);
+    static void replaceInHierarchy(const SpatialComponent & from, const SpatialComponent & to);
+    static void updateTransforms();
+    // Catches the previous transform of every spatial that changed last frame
+    // up to its current one. Spatials that didn't change are left alone
+    static void rollover(float dt);
+    // Sends a SpatialChangeMessage for each changed spatial, and one
+    // SpatialChangesMessage listing all of them, once their matrices are up
+    // to date. Returns the number changed
+    static int publishChanges();
+
     public:
 
     static const float k_terminalVelocity;
     static const float k_coefficientOfFriction;
     static const float k_elasticity;
     static const float k_bounceVelThreshold;
+    static const float k_sleepSpeed; // below which a newtonian is resting
+    static const int k_sleepFrames; // resting in a row before it falls asleep
 
     private:
 
     static const Vector<SpatialComponent *> & s_spatialComponents;
-    static const Vector<NewtonianComponent *> & s_newtonianComponents;
-    static const Vector<AcceleratorComponent *> & s_acceleratorComponents;
-    static const Vector<AnimationComponent *> & s_animationComponents;
     static glm::vec3 s_gravityDir;
     static float s_gravityMag;
+    static bool s_sleepEnabled;
+    static Vector<const SpatialComponent *> s_changed;
+    static std::mutex s_changedMutex;
+    static Vector<const SpatialComponent *> s_published; // referenced by the last SpatialChangesMessage
+    static Vector<const SpatialComponent *> s_moved; // changed since the last rollover
+    static float s_dt; // of the last rollover
+    static Vector<const SpatialComponent *> s_hierarchy; // parents before children
+    static std::mutex s_hierarchyMutex;
 
 };
\ No newline at end of file
@@ -9,6 +9,15 @@
 
 
 
+// Lists the component types a system reads or writes, so the scheduler knows
+// which systems can be updated at the same time
+template <typename... CompTs> struct ComponentTypes {};
+
+// Stands in for every component type, for systems that touch anything
+struct AllComponents {};
+
+
+
 // Systems are static classes, and static classes can't be polymorphic, but every
 // system should resemble the following...
 /*
@@ -18,6 +27,13 @@ class System {
 
     public:
 
+    // component types the system reads but does not change
+    using Reads = ComponentTypes<...>;
+    // component types the system changes, including by way of the messages
+    // it sends. Note that reading a spatial's absolute transform can fill in
+    // its cached matrices, which counts as a write
+    using Writes = ComponentTypes<...>;
+
     // setup system
     static void init();
 
@@ -26,6 +42,10 @@ class System {
 
 };
 */
+// A system whose reads and writes don't overlap with those of the system before
+// it may be updated at the same time, on a different thread. While that happens, messages sent and game objects or
+// components created or destroyed are held per system, and handed over in the
+// order the systems were added to the scheduler. See Scheduler.hpp
 
 
 
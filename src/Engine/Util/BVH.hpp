@@ -0,0 +1,86 @@
+#pragma once
+
+
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+#include "glm/glm.hpp"
+#include "glm/gtx/component_wise.hpp"
+
+#include "Memory.hpp"
+#include "Util/Geometry.hpp"
+#include "Util/Util.hpp"
+
+
+
+// Bounding volume hierarchy over elements that never move. It's built once,
+// top down, splitting each node where the surface area heuristic says rays
+// and regions are least likely to have to look at both halves. The nodes are
+// laid out in one array in depth first order, so a node's first child is the
+// one right after it, and the elements are kept in leaf order alongside their
+// regions. There's no adding, only building anew, and taking an element out
+// leaves the nodes above it as big as they were.
+template <typename T>
+class BVH {
+
+    static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+    static_assert(std::is_copy_constructible<T>::value, "T must be copy constructable");
+    static_assert(std::is_copy_assignable<T>::value, "T must be copy assignable");
+
+    struct Node {
+        AABox region;
+        uint32_t offset; // first element if a leaf, second child otherwise
+        uint16_t count; // number of elements, 0 if not a leaf or if they've all been taken out
+        uint8_t axis; // axis the children were split along, or k_bvhLeaf
+    };
+
+    struct Prim {
+        T e;
+        AABox region;
+        glm::vec3 center;
+    };
+
+    public:
+
+    BVH();
+
+    // Replaces whatever's there with the given elements and their regions
+    void build(const Vector<std::pair<T, AABox>> & elements);
+
+    // Takes the element out, returning whether it was there
+    bool remove(T e);
+
+    void clear();
+
+    size_t size() const { return m_size; }
+
+    // Retrieves the nearest element and intersection with the given ray.
+    // F takes a ray and an element and returns an Intersect.
+    std::pair<T, Intersect> filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const;
+    // Retrieves every element whose region overlaps the given region
+    size_t filter(const AABox & region, Vector<T> & r_results) const;
+
+    private:
+
+    // Builds the node for the prims in [begin, end) and everything below it
+    void build(Vector<Prim> & prims, uint32_t begin, uint32_t end, int depth);
+
+    static AABox merge(const AABox & b1, const AABox & b2);
+    static float surfaceArea(const AABox & box);
+    static bool overlaps(const AABox & b1, const AABox & b2);
+    static bool intersect(const Ray & ray, const glm::vec3 & invDir, const AABox & box, float & r_near);
+
+    private:
+
+    Vector<Node> m_nodes;
+    Vector<T> m_elements;
+    Vector<AABox> m_regions;
+    size_t m_size;
+
+};
+
+
+
+#include "BVH.tpp"
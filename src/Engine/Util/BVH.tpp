@@ -0,0 +1,291 @@
+namespace detail {
+
+constexpr int k_bvhBins(12); // candidate split planes per axis are between these
+constexpr uint32_t k_bvhMaxLeafSize(4); // a leaf is only made bigger than this if there's no way to split it
+constexpr float k_bvhTraversalCost(1.0f); // relative to testing one element
+constexpr int k_bvhMaxDepth(60); // past this everything left goes in one leaf, so traversal stacks are bounded
+constexpr uint8_t k_bvhLeaf(3); // the axis a leaf is marked with
+
+}
+
+
+
+template <typename T>
+BVH<T>::BVH() :
+    m_nodes(),
+    m_elements(),
+    m_regions(),
+    m_size(0)
+{}
+
+template <typename T>
+void BVH<T>::build(const Vector<std::pair<T, AABox>> & elements) {
+    MemoryScope memoryScope(MemoryCategory::Collision);
+    clear();
+    if (elements.empty()) {
+        return;
+    }
+
+    Vector<Prim> prims;
+    prims.reserve(elements.size());
+    for (const auto & pair : elements) {
+        prims.push_back(Prim{ pair.first, pair.second, pair.second.center() });
+    }
+
+    m_nodes.reserve(2 * prims.size());
+    m_elements.reserve(prims.size());
+    m_regions.reserve(prims.size());
+    build(prims, 0, uint32_t(prims.size()), 0);
+    m_nodes.shrink_to_fit();
+    m_size = m_elements.size();
+}
+
+template <typename T>
+bool BVH<T>::remove(T e) {
+    for (Node & node : m_nodes) {
+        if (node.axis != detail::k_bvhLeaf) {
+            continue;
+        }
+        for (uint32_t i(node.offset); i < node.offset + node.count; ++i) {
+            if (m_elements[i] == e) {
+                // the leaf's last element takes its place
+                uint32_t last(node.offset + --node.count);
+                m_elements[i] = m_elements[last];
+                m_regions[i] = m_regions[last];
+                --m_size;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void BVH<T>::clear() {
+    m_nodes.clear();
+    m_elements.clear();
+    m_regions.clear();
+    m_size = 0;
+}
+
+template <typename T>
+std::pair<T, Intersect> BVH<T>::filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const {
+    std::pair<T, Intersect> res{};
+    if (m_nodes.empty()) {
+        return res;
+    }
+
+    glm::vec3 invDir(
+        Util::isZero(ray.dir.x) ? Util::infinity() : 1.0f / ray.dir.x,
+        Util::isZero(ray.dir.y) ? Util::infinity() : 1.0f / ray.dir.y,
+        Util::isZero(ray.dir.z) ? Util::infinity() : 1.0f / ray.dir.z
+    );
+    float near;
+    if (!intersect(ray, invDir, m_nodes[0].region, near)) {
+        return res;
+    }
+
+    // nodes still to visit, and how near the ray gets to each
+    std::pair<uint32_t, float> stack[detail::k_bvhMaxDepth + 2];
+    int nStack(0);
+    stack[nStack++] = { 0, near };
+    while (nStack) {
+        std::pair<uint32_t, float> top(stack[--nStack]);
+        // something nearer has been hit since this was pushed
+        if (top.second >= res.second.dist) {
+            continue;
+        }
+        const Node & node(m_nodes[top.first]);
+
+        if (node.axis == detail::k_bvhLeaf) {
+            for (uint32_t i(node.offset); i < node.offset + node.count; ++i) {
+                if (!intersect(ray, invDir, m_regions[i], near) || near >= res.second.dist) {
+                    continue;
+                }
+                Intersect potential(f(ray, m_elements[i]));
+                if (potential.dist < res.second.dist) {
+                    res.first = m_elements[i];
+                    res.second = potential;
+                }
+            }
+            continue;
+        }
+
+        // the child on the side the ray comes from is pushed last, so it's
+        // visited first
+        uint32_t first(top.first + 1), second(node.offset);
+        if (ray.dir[node.axis] < 0.0f) {
+            std::swap(first, second);
+        }
+        float firstNear, secondNear;
+        bool hitFirst(intersect(ray, invDir, m_nodes[first].region, firstNear) && firstNear < res.second.dist);
+        bool hitSecond(intersect(ray, invDir, m_nodes[second].region, secondNear) && secondNear < res.second.dist);
+        if (hitSecond) stack[nStack++] = { second, secondNear };
+        if (hitFirst) stack[nStack++] = { first, firstNear };
+    }
+    return res;
+}
+
+template <typename T>
+size_t BVH<T>::filter(const AABox & region, Vector<T> & r_results) const {
+    if (m_nodes.empty()) {
+        return 0;
+    }
+
+    size_t n(0);
+    uint32_t stack[detail::k_bvhMaxDepth + 2];
+    int nStack(0);
+    stack[nStack++] = 0;
+    while (nStack) {
+        uint32_t nodeI(stack[--nStack]);
+        const Node & node(m_nodes[nodeI]);
+        if (!overlaps(node.region, region)) {
+            continue;
+        }
+        if (node.axis == detail::k_bvhLeaf) {
+            for (uint32_t i(node.offset); i < node.offset + node.count; ++i) {
+                if (overlaps(m_regions[i], region)) {
+                    r_results.push_back(m_elements[i]);
+                    ++n;
+                }
+            }
+        }
+        else {
+            stack[nStack++] = node.offset;
+            stack[nStack++] = nodeI + 1;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+void BVH<T>::build(Vector<Prim> & prims, uint32_t begin, uint32_t end, int depth) {
+    uint32_t nodeI(uint32_t(m_nodes.size()));
+    m_nodes.emplace_back();
+
+    AABox region(prims[begin].region), centers(prims[begin].center, prims[begin].center);
+    for (uint32_t i(begin + 1); i < end; ++i) {
+        region = merge(region, prims[i].region);
+        centers = merge(centers, AABox(prims[i].center, prims[i].center));
+    }
+    m_nodes[nodeI].region = region;
+    uint32_t n(end - begin);
+
+    // split along the axis the centers are most spread out on
+    glm::vec3 spread(centers.max - centers.min);
+    int axis(spread.x >= spread.y && spread.x >= spread.z ? 0 : spread.y >= spread.z ? 1 : 2);
+    float minCenter(centers.min[axis]), extent(spread[axis]);
+
+    int bestSplit(0);
+    float bestCost(static_cast<float>(n)); // of leaving them all in a leaf
+    if (n > 1 && extent > 0.0f) {
+        int binCounts[detail::k_bvhBins] = {};
+        AABox binRegions[detail::k_bvhBins];
+        float binScale(float(detail::k_bvhBins) / extent);
+        for (uint32_t i(begin); i < end; ++i) {
+            int b(glm::min(int((prims[i].center[axis] - minCenter) * binScale), detail::k_bvhBins - 1));
+            binRegions[b] = binCounts[b] ? merge(binRegions[b], prims[i].region) : prims[i].region;
+            ++binCounts[b];
+        }
+
+        // area and count of everything above each split, swept from the top
+        float aboveAreas[detail::k_bvhBins];
+        int aboveCounts[detail::k_bvhBins];
+        AABox above;
+        int nAbove(0);
+        for (int b(detail::k_bvhBins - 1); b > 0; --b) {
+            if (binCounts[b]) {
+                above = nAbove ? merge(above, binRegions[b]) : binRegions[b];
+                nAbove += binCounts[b];
+            }
+            aboveAreas[b] = nAbove ? surfaceArea(above) : 0.0f;
+            aboveCounts[b] = nAbove;
+        }
+
+        // then below each split, from the bottom
+        float invArea(1.0f / glm::max(surfaceArea(region), std::numeric_limits<float>::min()));
+        AABox below;
+        int nBelow(0);
+        for (int b(1); b < detail::k_bvhBins; ++b) {
+            if (binCounts[b - 1]) {
+                below = nBelow ? merge(below, binRegions[b - 1]) : binRegions[b - 1];
+                nBelow += binCounts[b - 1];
+            }
+            if (!nBelow || !aboveCounts[b]) {
+                continue;
+            }
+            float cost(detail::k_bvhTraversalCost + (surfaceArea(below) * float(nBelow) + aboveAreas[b] * float(aboveCounts[b])) * invArea);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+    }
+
+    // small enough that testing them all beats splitting, or there's no
+    // splitting them, or deep enough that the traversal stacks are full
+    bool isLeaf(depth >= detail::k_bvhMaxDepth || (n <= detail::k_bvhMaxLeafSize ? !bestSplit || bestCost >= float(n) : extent <= 0.0f));
+    if (isLeaf) {
+        m_nodes[nodeI].offset = uint32_t(m_elements.size());
+        m_nodes[nodeI].count = uint16_t(n);
+        m_nodes[nodeI].axis = detail::k_bvhLeaf;
+        for (uint32_t i(begin); i < end; ++i) {
+            m_elements.push_back(prims[i].e);
+            m_regions.push_back(prims[i].region);
+        }
+        return;
+    }
+
+    uint32_t midI;
+    if (bestSplit) {
+        float binScale(float(detail::k_bvhBins) / extent);
+        auto mid(std::partition(prims.begin() + begin, prims.begin() + end, [&](const Prim & prim) {
+            return glm::min(int((prim.center[axis] - minCenter) * binScale), detail::k_bvhBins - 1) < bestSplit;
+        }));
+        midI = uint32_t(mid - prims.begin());
+    }
+    else {
+        // they overlap so much no split helps, but there are too many to
+        // leave in one leaf, so they're halved
+        midI = (begin + end) / 2;
+        std::nth_element(prims.begin() + begin, prims.begin() + midI, prims.begin() + end, [&](const Prim & p1, const Prim & p2) {
+            return p1.center[axis] < p2.center[axis];
+        });
+    }
+
+    m_nodes[nodeI].count = 0;
+    m_nodes[nodeI].axis = uint8_t(axis);
+    build(prims, begin, midI, depth + 1);
+    m_nodes[nodeI].offset = uint32_t(m_nodes.size());
+    build(prims, midI, end, depth + 1);
+}
+
+template <typename T>
+AABox BVH<T>::merge(const AABox & b1, const AABox & b2) {
+    return AABox(glm::min(b1.min, b2.min), glm::max(b1.max, b2.max));
+}
+
+template <typename T>
+float BVH<T>::surfaceArea(const AABox & box) {
+    glm::vec3 size(box.max - box.min);
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+template <typename T>
+bool BVH<T>::overlaps(const AABox & b1, const AABox & b2) {
+    return
+        b1.min.x <= b2.max.x && b2.min.x <= b1.max.x &&
+        b1.min.y <= b2.max.y && b2.min.y <= b1.max.y &&
+        b1.min.z <= b2.max.z && b2.min.z <= b1.max.z;
+}
+
+template <typename T>
+bool BVH<T>::intersect(const Ray & ray, const glm::vec3 & invDir, const AABox & box, float & r_near) {
+    glm::vec3 tsLow((box.min - ray.pos) * invDir);
+    glm::vec3 tsHigh((box.max - ray.pos) * invDir);
+    float tMin(glm::compMax(glm::min(tsLow, tsHigh)));
+    float tMax(glm::compMin(glm::max(tsLow, tsHigh)));
+    r_near = glm::max(tMin, 0.0f);
+    // extra negation so that a NaN case is skipped
+    return tMax > 0.0f && tMax >= tMin;
+}
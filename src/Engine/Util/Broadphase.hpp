@@ -0,0 +1,37 @@
+#pragma once
+
+
+
+#include <functional>
+
+#include "Memory.hpp"
+#include "Util/Geometry.hpp"
+
+
+
+// Keeps elements by their axis aligned bounds, and narrows down which of them
+// might touch a region or ray. Elements themselves are never tested, that's
+// left to the caller
+template <typename T>
+class Broadphase {
+
+    public:
+
+    virtual ~Broadphase() = default;
+
+    // Adds the element, or moves it if it's already there. Returns false if
+    // the region is out of bounds
+    virtual bool set(T e, const AABox & region) = 0;
+
+    virtual bool remove(T e) = 0;
+
+    virtual void clear() = 0;
+
+    // Retrieves the nearest element and intersection with the given ray.
+    // F takes a ray and an element and returns an Intersect.
+    virtual std::pair<T, Intersect> filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const = 0;
+    // Retrieves at least every element whose region overlaps the given
+    // element's, possibly along with the element itself.
+    virtual size_t filter(T e, Vector<T> & r_results) const = 0;
+
+};
@@ -0,0 +1,193 @@
+#include "JobSystem.hpp"
+
+#include <cassert>
+
+#include "Profiler.hpp"
+
+
+
+namespace {
+
+// index of the queue belonging to this thread. Threads that aren't workers
+// share the main thread's
+thread_local int t_queueIndex(0);
+
+}
+
+
+
+Vector<std::thread> JobSystem::s_workers;
+Vector<UniquePtr<JobSystem::Queue>> JobSystem::s_queues;
+std::atomic<bool> JobSystem::s_running(false);
+std::atomic<int> JobSystem::s_nQueued(0);
+std::mutex JobSystem::s_sleepMutex;
+std::condition_variable JobSystem::s_sleepCV;
+
+void JobSystem::init(int nWorkers) {
+    assert(!s_running); // already initialized
+
+    if (nWorkers < 0) {
+        nWorkers = int(std::thread::hardware_concurrency()) - 1;
+    }
+    if (nWorkers < 0) {
+        nWorkers = 0;
+    }
+
+    s_running = true;
+    Profiler::setThreadName("Main");
+    for (int i(0); i <= nWorkers; ++i) {
+        s_queues.emplace_back(UniquePtr<Queue>::make());
+        s_queues.back()->front = 0;
+    }
+    for (int i(1); i <= nWorkers; ++i) {
+        s_workers.emplace_back(&JobSystem::workerMain, i);
+    }
+}
+
+void JobSystem::shutDown() {
+    {
+        std::lock_guard<std::mutex> lock(s_sleepMutex);
+        s_running = false;
+    }
+    s_sleepCV.notify_all();
+    for (std::thread & worker : s_workers) {
+        worker.join();
+    }
+    s_workers.clear();
+    s_queues.clear();
+}
+
+void JobSystem::run(void (*f)(const void *, int, int), const void * data, int begin, int end, JobCounter & counter, JobCounter * after) {
+    Job job{ f, data, begin, end, &counter };
+    counter.m_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (after && !after->done()) {
+        std::lock_guard<std::mutex> lock(after->m_mutex);
+        // check again, as it may have finished in the meantime
+        if (!after->done()) {
+            after->m_dependents.push_back(job);
+            return;
+        }
+    }
+    push(job);
+}
+
+void JobSystem::wait(JobCounter & counter) {
+    while (!counter.done()) {
+        if (!runOne()) {
+            std::this_thread::yield();
+        }
+    }
+    // the last job may still be holding the lock, and the counter is likely
+    // about to go out of scope
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::workerMain(int index) {
+    initializeThreadMemory();
+    t_queueIndex = index;
+    Profiler::setThreadName(String("Worker ") + std::to_string(index).c_str());
+
+    while (true) {
+        if (runOne()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(s_sleepMutex);
+        s_sleepCV.wait(lock, []() { return s_nQueued > 0 || !s_running; });
+        if (!s_running) {
+            break;
+        }
+    }
+
+    finalizeThreadMemory();
+}
+
+void JobSystem::push(const Job & job) {
+    // no one else to run it
+    if (s_workers.empty()) {
+        execute(job);
+        return;
+    }
+
+    Queue & queue(*s_queues[t_queueIndex]);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(s_sleepMutex);
+        ++s_nQueued;
+    }
+    s_sleepCV.notify_one();
+}
+
+bool JobSystem::pop(Job & r_job) {
+    Queue & queue(*s_queues[t_queueIndex]);
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.front == queue.jobs.size()) {
+        return false;
+    }
+    r_job = queue.jobs.back();
+    queue.jobs.pop_back();
+    if (queue.front == queue.jobs.size()) {
+        queue.jobs.clear();
+        queue.front = 0;
+    }
+    return true;
+}
+
+bool JobSystem::steal(Job & r_job) {
+    int n(int(s_queues.size()));
+    for (int i(1); i < n; ++i) {
+        Queue & queue(*s_queues[(t_queueIndex + i) % n]);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.front == queue.jobs.size()) {
+            continue;
+        }
+        r_job = queue.jobs[queue.front++];
+        if (queue.front == queue.jobs.size()) {
+            queue.jobs.clear();
+            queue.front = 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::runOne() {
+    if (s_queues.empty()) {
+        return false;
+    }
+    Job job;
+    if (!pop(job) && !steal(job)) {
+        return false;
+    }
+    --s_nQueued;
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const Job & job) {
+    job.f(job.data, job.begin, job.end);
+
+    JobCounter & counter(*job.counter);
+    int count(counter.m_count.load(std::memory_order_acquire));
+    while (count > 1) {
+        if (counter.m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+    // this may be the last one, in which case anything waiting on the counter
+    // is released. Done under the lock so the counter isn't touched after a
+    // waiter could see it finish
+    Vector<Job> dependents;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        if (counter.m_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::swap(dependents, counter.m_dependents);
+        }
+    }
+    for (const Job & dependent : dependents) {
+        push(dependent);
+    }
+}
@@ -0,0 +1,152 @@
+/* Job system
+ * Pool of worker threads that share out small jobs by stealing from each other */
+#pragma once
+#ifndef _JOB_SYSTEM_HPP_
+#define _JOB_SYSTEM_HPP_
+
+
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "Memory.hpp"
+
+
+
+class JobSystem;
+class JobCounter;
+
+
+
+// A job runs f(data, begin, end) and then takes one off counter
+struct Job {
+    void (*f)(const void *, int, int);
+    const void * data;
+    int begin, end;
+    JobCounter * counter;
+};
+
+
+
+// Counts jobs that haven't finished yet. Wait on one to block until its jobs
+// are done, or make other jobs depend on it so they only start after
+class JobCounter {
+
+    friend JobSystem;
+
+    public:
+
+    JobCounter() : m_count(0), m_mutex(), m_dependents() {}
+    JobCounter(const JobCounter & other) = delete;
+    JobCounter & operator=(const JobCounter & other) = delete;
+
+    bool done() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+    private:
+
+    std::atomic<int> m_count;
+    std::mutex m_mutex;
+    Vector<Job> m_dependents; // submitted once the count hits zero
+
+};
+
+
+
+// static class
+class JobSystem {
+
+    public:
+
+    // Starts the worker threads. By default there is one per core, minus the
+    // main thread, which also runs jobs while waiting
+    static void init(int nWorkers = -1);
+
+    static void shutDown();
+
+    // Queues f(data, begin, end). If after is not null, the job is held back
+    // until after is done. data must outlive the job
+    static void run(void (*f)(const void *, int, int), const void * data, int begin, int end, JobCounter & counter, JobCounter * after = nullptr);
+
+    // Runs jobs until counter is done, so the calling thread is never idle
+    static void wait(JobCounter & counter);
+
+    // Calls f(i) for every i in [begin, end), split into jobs of grainSize
+    // indices, and returns once all are done. Runs serially if there are no
+    // workers or the range fits in one job
+    template <typename F> static void parallelFor(int begin, int end, int grainSize, const F & f);
+
+    // Number of threads running jobs, including the main thread
+    static int threadCount() { return int(s_workers.size()) + 1; }
+
+    private:
+
+    // A deque of jobs per thread. The owner pushes and pops at the back, and
+    // other threads steal from the front, so recently queued, cache warm work
+    // stays local
+    struct Queue {
+        std::mutex mutex;
+        Vector<Job> jobs;
+        size_t front;
+    };
+
+    static void workerMain(int index);
+
+    static void push(const Job & job);
+    static bool pop(Job & r_job);
+    static bool steal(Job & r_job);
+    // Runs one job, if there is any to be had. Returns whether one was run
+    static bool runOne();
+    static void execute(const Job & job);
+
+    template <typename F> static void parallelForThunk(const void * f, int begin, int end);
+
+    private:
+
+    static Vector<std::thread> s_workers;
+    static Vector<UniquePtr<Queue>> s_queues; // index 0 belongs to the main thread
+    static std::atomic<bool> s_running;
+    static std::atomic<int> s_nQueued;
+    static std::mutex s_sleepMutex;
+    static std::condition_variable s_sleepCV;
+
+};
+
+
+
+// TEMPLATE IMPLEMENTATION /////////////////////////////////////////////////////
+
+
+
+template <typename F>
+void JobSystem::parallelFor(int begin, int end, int grainSize, const F & f) {
+    if (grainSize < 1) {
+        grainSize = 1;
+    }
+    if (s_workers.empty() || end - begin <= grainSize) {
+        for (int i(begin); i < end; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    JobCounter counter;
+    for (int i(begin); i < end; i += grainSize) {
+        run(&parallelForThunk<F>, &f, i, std::min(i + grainSize, end), counter);
+    }
+    wait(counter);
+}
+
+template <typename F>
+void JobSystem::parallelForThunk(const void * f, int begin, int end) {
+    const F & func(*static_cast<const F *>(f));
+    for (int i(begin); i < end; ++i) {
+        func(i);
+    }
+}
+
+
+
+#endif
@@ -1,5 +1,10 @@
 #include "Memory.hpp"
 
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <new>
+
 #ifdef USE_RPMALLOC
 
 #include "ThirdParty/CoherentLabs_rpmalloc/rpmalloc.h"
@@ -18,4 +23,307 @@ int InitializeMemory::initialized = 0;
 
 }
 
-#endif
\ No newline at end of file
+#endif
+
+
+namespace {
+
+#ifdef TRACK_MEMORY
+
+// Each thread's counters. Only the owning thread writes them, so plain loads
+// and stores will do, but they are atomic so the main thread can read them
+struct ThreadMemory {
+    struct Counters {
+        std::atomic<int64_t> liveBytes;
+        std::atomic<int64_t> peakBytes;
+        std::atomic<int64_t> allocations;
+        std::atomic<int64_t> allocatedBytes;
+    };
+
+    std::atomic<bool> inUse;
+    MemoryCategory category;
+    Counters counters[MemoryStats::k_nCategories];
+};
+
+struct MemoryHeader {
+    size_t size;
+    MemoryCategory category;
+};
+
+static_assert(sizeof(MemoryHeader) <= detail::k_memoryHeaderSize, "MemoryHeader doesn't fit");
+
+// can't allocate themselves, so these are fixed and constant initialized
+ThreadMemory s_threadMemory[MemoryStats::k_maxThreads];
+std::atomic<int> s_nThreadMemory(0); // ever used
+thread_local ThreadMemory * t_threadMemory(nullptr);
+
+ThreadMemory & threadMemory() {
+    if (t_threadMemory) {
+        return *t_threadMemory;
+    }
+    // take over the slot of a thread that has finished, if there is one, so
+    // its counters carry on
+    for (int i(0); i < MemoryStats::k_maxThreads; ++i) {
+        bool expected(false);
+        if (s_threadMemory[i].inUse.compare_exchange_strong(expected, true)) {
+            int n(s_nThreadMemory.load());
+            while (n <= i && !s_nThreadMemory.compare_exchange_weak(n, i + 1)) {}
+            s_threadMemory[i].category = MemoryCategory::General;
+            t_threadMemory = &s_threadMemory[i];
+            return *t_threadMemory;
+        }
+    }
+    assert(false); // more than k_maxThreads threads allocating at once
+    std::abort();
+}
+
+void add(std::atomic<int64_t> & counter, int64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+#endif
+
+}
+
+
+
+#ifdef TRACK_MEMORY
+
+void * detail::trackAllocation(void * mem, size_t size) {
+    if (!mem) {
+        return nullptr;
+    }
+    ThreadMemory & thread(threadMemory());
+    new (mem) MemoryHeader{ size, thread.category };
+
+    ThreadMemory::Counters & counters(thread.counters[int(thread.category)]);
+    add(counters.liveBytes, int64_t(size));
+    if (counters.liveBytes.load(std::memory_order_relaxed) > counters.peakBytes.load(std::memory_order_relaxed)) {
+        counters.peakBytes.store(counters.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    add(counters.allocations, 1);
+    add(counters.allocatedBytes, int64_t(size));
+
+    return static_cast<unsigned char *>(mem) + k_memoryHeaderSize;
+}
+
+void * detail::trackDeallocation(void * ptr) {
+    void * mem(static_cast<unsigned char *>(ptr) - k_memoryHeaderSize);
+    const MemoryHeader & header(*static_cast<const MemoryHeader *>(mem));
+    add(threadMemory().counters[int(header.category)].liveBytes, -int64_t(header.size));
+    return mem;
+}
+
+MemoryCategory detail::swapMemoryCategory(MemoryCategory category) {
+    ThreadMemory & thread(threadMemory());
+    MemoryCategory prev(thread.category);
+    thread.category = category;
+    return prev;
+}
+
+void detail::countAllocation(MemoryCategory category, size_t size) {
+    ThreadMemory::Counters & counters(threadMemory().counters[int(category)]);
+    add(counters.allocations, 1);
+    add(counters.allocatedBytes, int64_t(size));
+}
+
+void detail::releaseThreadMemory() {
+    if (t_threadMemory) {
+        t_threadMemory->inUse.store(false);
+        t_threadMemory = nullptr;
+    }
+}
+
+#endif
+
+
+
+namespace {
+
+// Memory for a frame arena, with the block header in front
+struct FrameBlock {
+    FrameBlock * prev;
+    size_t size; // not including the header
+};
+
+constexpr size_t k_minFrameBlockSize = 64 * 1024;
+
+// A thread's frame arena. Grows a block at a time during a frame, and is put
+// back into a single block big enough for the whole frame when reset
+struct ThreadFrameArena {
+
+    FrameBlock * block = nullptr;
+    unsigned char * cur = nullptr;
+    unsigned char * end = nullptr;
+    uint32_t frame = 0;
+
+    ~ThreadFrameArena() {
+        release();
+    }
+
+    unsigned char * data(FrameBlock * b) {
+        return reinterpret_cast<unsigned char *>(b) + sizeof(FrameBlock);
+    }
+
+    void push(size_t size) {
+        MemoryScope memoryScope(MemoryCategory::Frame);
+        FrameBlock * b(static_cast<FrameBlock *>(::allocate(sizeof(FrameBlock) + size)));
+        b->prev = block;
+        b->size = size;
+        block = b;
+        cur = data(b);
+        end = cur + size;
+    }
+
+    void grow(size_t size) {
+        push(std::max(std::max(size, k_minFrameBlockSize), block ? block->size * 2 : 0));
+    }
+
+    void reset() {
+        if (!block) {
+            return;
+        }
+        if (block->prev) {
+            size_t total(0);
+            for (FrameBlock * b(block); b; b = b->prev) {
+                total += b->size;
+            }
+            release();
+            push(total);
+        }
+        cur = data(block);
+    }
+
+    void release() {
+        while (block) {
+            FrameBlock * prev(block->prev);
+            ::deallocate(block);
+            block = prev;
+        }
+        cur = end = nullptr;
+    }
+
+};
+
+thread_local ThreadFrameArena t_frameArena;
+
+unsigned char * alignUp(unsigned char * ptr, size_t alignment) {
+    uintptr_t p(reinterpret_cast<uintptr_t>(ptr));
+    return reinterpret_cast<unsigned char *>((p + alignment - 1) & ~uintptr_t(alignment - 1));
+}
+
+}
+
+
+
+std::atomic<uint32_t> FrameArena::s_frame(0);
+
+void * FrameArena::allocate(size_t size, size_t alignment) {
+    ThreadFrameArena & arena(t_frameArena);
+    uint32_t frame(s_frame.load(std::memory_order_relaxed));
+    if (arena.frame != frame) {
+        arena.reset();
+        arena.frame = frame;
+    }
+
+    unsigned char * ptr(alignUp(arena.cur, alignment));
+    if (!arena.block || ptr + size > arena.end) {
+        arena.grow(size + alignment);
+        ptr = alignUp(arena.cur, alignment);
+    }
+    arena.cur = ptr + size;
+
+#ifdef TRACK_MEMORY
+    detail::countAllocation(MemoryCategory::Frame, size);
+#endif
+    return ptr;
+}
+
+void FrameArena::deallocate(void * ptr, size_t size) {
+    // so a growing vector can reuse its own space
+    ThreadFrameArena & arena(t_frameArena);
+    if (static_cast<unsigned char *>(ptr) + size == arena.cur) {
+        arena.cur = static_cast<unsigned char *>(ptr);
+    }
+}
+
+void detail::releaseFrameArena() {
+    t_frameArena.release();
+}
+
+
+
+MemoryStats::Counters MemoryStats::s_totals[k_nCategories];
+MemoryStats::Counters MemoryStats::s_threads[k_maxThreads][k_nCategories];
+int64_t MemoryStats::s_lastAllocations[k_maxThreads][k_nCategories];
+int64_t MemoryStats::s_lastBytes[k_maxThreads][k_nCategories];
+int MemoryStats::s_nThreads(0);
+int MemoryStats::s_frame(0);
+std::FILE * MemoryStats::s_csv(nullptr);
+
+const char * MemoryStats::name(MemoryCategory category) {
+    static const char * const k_names[k_nCategories]{ "General", "Scene", "Collision", "Octree", "Messages", "Particles", "Loader", "Frame" };
+    return k_names[int(category)];
+}
+
+void MemoryStats::endFrame() {
+#ifdef TRACK_MEMORY
+    s_nThreads = s_nThreadMemory.load();
+    for (int c(0); c < k_nCategories; ++c) {
+        Counters & total(s_totals[c]);
+        total.liveBytes = 0;
+        total.frameAllocations = 0;
+        total.frameBytes = 0;
+        for (int t(0); t < s_nThreads; ++t) {
+            const ThreadMemory::Counters & counters(s_threadMemory[t].counters[c]);
+            int64_t allocations(counters.allocations.load(std::memory_order_relaxed));
+            int64_t bytes(counters.allocatedBytes.load(std::memory_order_relaxed));
+            Counters & thread(s_threads[t][c]);
+            thread.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+            thread.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+            thread.frameAllocations = allocations - s_lastAllocations[t][c];
+            thread.frameBytes = bytes - s_lastBytes[t][c];
+            s_lastAllocations[t][c] = allocations;
+            s_lastBytes[t][c] = bytes;
+
+            total.liveBytes += thread.liveBytes;
+            total.frameAllocations += thread.frameAllocations;
+            total.frameBytes += thread.frameBytes;
+        }
+        if (total.liveBytes > total.peakBytes) {
+            total.peakBytes = total.liveBytes;
+        }
+    }
+#endif
+
+    if (s_csv) {
+        std::fprintf(s_csv, "%d", s_frame);
+        for (const Counters & total : s_totals) {
+            std::fprintf(s_csv, ",%lld,%lld,%lld,%lld", (long long)(total.liveBytes), (long long)(total.peakBytes), (long long)(total.frameAllocations), (long long)(total.frameBytes));
+        }
+        std::fprintf(s_csv, "\n");
+    }
+    ++s_frame;
+}
+
+bool MemoryStats::openCSV(const char * filename) {
+    closeCSV();
+    s_csv = std::fopen(filename, "w");
+    if (!s_csv) {
+        return false;
+    }
+    std::fprintf(s_csv, "frame");
+    for (int c(0); c < k_nCategories; ++c) {
+        const char * category(name(MemoryCategory(c)));
+        std::fprintf(s_csv, ",%s live,%s peak,%s allocations,%s bytes", category, category, category, category);
+    }
+    std::fprintf(s_csv, "\n");
+    return true;
+}
+
+void MemoryStats::closeCSV() {
+    if (s_csv) {
+        std::fclose(s_csv);
+        s_csv = nullptr;
+    }
+}
@@ -14,6 +14,9 @@
 #include <map>
 #include <unordered_map>
 #include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
 
 
 #ifdef USE_RPMALLOC
@@ -49,7 +52,25 @@ static InitializeMemory f_initializeMemory;
 
 
 
-inline void * allocate(size_t size) {
+// What memory is being allocated for. Allocations are counted against the
+// category of the innermost MemoryScope on their thread
+enum class MemoryCategory : int {
+    General,
+    Scene,
+    Collision,
+    Octree,
+    Messages,
+    Particles,
+    Loader,
+    Frame, // the frame arenas' blocks. Allocations are those the arenas served
+    Count
+};
+
+
+
+namespace detail {
+
+inline void * systemAllocate(size_t size) {
 #ifdef USE_RPMALLOC
     return coherent_rpmalloc::rpmalloc(size);
 #else
@@ -57,7 +78,7 @@ inline void * allocate(size_t size) {
 #endif
 }
 
-inline void deallocate(void * ptr) {
+inline void systemDeallocate(void * ptr) {
 #ifdef USE_RPMALLOC
     return coherent_rpmalloc::rpfree(ptr);
 #else
@@ -65,6 +86,148 @@ inline void deallocate(void * ptr) {
 #endif
 }
 
+#ifdef TRACK_MEMORY
+
+// Tracked allocations are prefixed with their size and category. Big enough
+// to keep them 16 byte aligned
+constexpr size_t k_memoryHeaderSize = 16;
+
+// Counts mem, an allocation of size plus header, and returns the part after
+// the header
+void * trackAllocation(void * mem, size_t size);
+
+// Uncounts ptr, and returns the start of its allocation
+void * trackDeallocation(void * ptr);
+
+// Returns the previous category
+MemoryCategory swapMemoryCategory(MemoryCategory category);
+
+// Counts an allocation that doesn't come from allocate
+void countAllocation(MemoryCategory category, size_t size);
+
+void releaseThreadMemory();
+
+#endif
+
+void releaseFrameArena();
+
+}
+
+
+
+inline void * allocate(size_t size) {
+#ifdef TRACK_MEMORY
+    return detail::trackAllocation(detail::systemAllocate(size + detail::k_memoryHeaderSize), size);
+#else
+    return detail::systemAllocate(size);
+#endif
+}
+
+inline void deallocate(void * ptr) {
+#ifdef TRACK_MEMORY
+    if (ptr) {
+        detail::systemDeallocate(detail::trackDeallocation(ptr));
+    }
+#else
+    detail::systemDeallocate(ptr);
+#endif
+}
+
+// Must be called on any thread other than main before it allocates
+inline void initializeThreadMemory() {
+#ifdef USE_RPMALLOC
+    coherent_rpmalloc::rpmalloc_thread_initialize();
+#endif
+}
+
+// Called on a thread before it exits to give back its cached memory
+inline void finalizeThreadMemory() {
+    detail::releaseFrameArena();
+#ifdef USE_RPMALLOC
+    coherent_rpmalloc::rpmalloc_thread_reset();
+#endif
+#ifdef TRACK_MEMORY
+    detail::releaseThreadMemory();
+#endif
+}
+
+
+
+// Counts allocations made on this thread against category while in scope
+class MemoryScope {
+
+    public:
+
+    explicit MemoryScope(MemoryCategory category) :
+        m_prev(category)
+    {
+#ifdef TRACK_MEMORY
+        m_prev = detail::swapMemoryCategory(category);
+#endif
+    }
+
+    ~MemoryScope() {
+#ifdef TRACK_MEMORY
+        detail::swapMemoryCategory(m_prev);
+#endif
+    }
+
+    MemoryScope(const MemoryScope & other) = delete;
+    MemoryScope & operator=(const MemoryScope & other) = delete;
+
+    private:
+
+    MemoryCategory m_prev;
+
+};
+
+
+
+// static class
+// Gathers up every thread's allocation counters once a frame. Everything
+// reads zero unless built with TRACK_MEMORY
+class MemoryStats {
+
+    public:
+
+    struct Counters {
+        int64_t liveBytes; // a thread's may be negative if it frees what others allocated
+        int64_t peakBytes; // for all threads, the peak as of the end of a frame
+        int64_t frameAllocations;
+        int64_t frameBytes; // allocated during the frame
+    };
+
+    static constexpr int k_nCategories = int(MemoryCategory::Count);
+    static constexpr int k_maxThreads = 64; // alive at once
+
+    static const char * name(MemoryCategory category);
+
+    // Takes a snapshot of the counters, and writes it to the CSV if open.
+    // Called on the main thread at the end of every frame
+    static void endFrame();
+
+    // As of the last endFrame
+    static const Counters & total(MemoryCategory category) { return s_totals[int(category)]; }
+    static const Counters & thread(int thread, MemoryCategory category) { return s_threads[thread][int(category)]; }
+    static int threadCount() { return s_nThreads; }
+
+    // Writes a row of totals per frame, until closed
+    static bool openCSV(const char * filename);
+    static void closeCSV();
+    static bool isWritingCSV() { return s_csv != nullptr; }
+
+    private:
+
+    static Counters s_totals[k_nCategories];
+    static Counters s_threads[k_maxThreads][k_nCategories];
+    static int64_t s_lastAllocations[k_maxThreads][k_nCategories];
+    static int64_t s_lastBytes[k_maxThreads][k_nCategories];
+    static int s_nThreads;
+    static int s_frame;
+    static std::FILE * s_csv;
+
+};
+
 
 
 template <typename T>
@@ -108,7 +271,8 @@ bool operator!=(const Allocator<T1> & a1, const Allocator<T2> & a2) {
 #ifdef USE_RPMALLOC
 template <typename T> using ScopedAllocator = std::scoped_allocator_adaptor<Allocator<T>>;
 #else
-template <typename T> using ScopedAllocator = std::allocator<T>;
+// So that everything but strings can still be tracked
+template <typename T> using ScopedAllocator = Allocator<T>;
 #endif
 
 
@@ -116,7 +280,12 @@ template <typename T> using ScopedAllocator = std::allocator<T>;
 // Standard containers using custom memory allocator
 
 // std::string equivalent
+#ifdef USE_RPMALLOC
 using String = std::basic_string<char, std::char_traits<char>, ScopedAllocator<char>>;
+#else
+// libstdc++ can only hash strings with the standard allocator
+using String = std::string;
+#endif
 
 #ifdef USE_RPMALLOC
 
@@ -164,6 +333,84 @@ using UnorderedMap = std::unordered_map<K, V, H, E, ScopedAllocator<std::pair<co
 
 
 
+// static class
+// Bump allocator for data that doesn't outlive the frame. Each thread has its
+// own, so allocating never locks. Freeing only gives memory back if it was the
+// thread's last allocation, but everything is released at the end of the frame
+class FrameArena {
+
+    public:
+
+    static void * allocate(size_t size, size_t alignment);
+
+    static void deallocate(void * ptr, size_t size);
+
+    // Everything allocated from any thread's arena is gone after this. Each
+    // arena is reset the next time its thread allocates. Called at the end of
+    // every frame, while no jobs are running
+    static void endFrame() { s_frame.fetch_add(1, std::memory_order_relaxed); }
+
+    private:
+
+    static std::atomic<uint32_t> s_frame;
+
+};
+
+
+
+template <typename T>
+struct FrameAllocator {
+
+    template <typename U> friend struct FrameAllocator;
+
+    using value_type = T;
+    using pointer = T *;
+
+    FrameAllocator() = default;
+
+    ~FrameAllocator() = default;
+
+    template <typename U> FrameAllocator(const FrameAllocator<U> &) {}
+
+    pointer allocate(std::size_t n) {
+        return static_cast<pointer>(FrameArena::allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(pointer p, std::size_t n) {
+        FrameArena::deallocate(p, n * sizeof(T));
+    }
+
+};
+
+template <typename T1, typename T2>
+bool operator==(const FrameAllocator<T1> & a1, const FrameAllocator<T2> & a2) {
+    return true;
+}
+
+template <typename T1, typename T2>
+bool operator!=(const FrameAllocator<T1> & a1, const FrameAllocator<T2> & a2) {
+    return false;
+}
+
+
+
+// Standard containers using the frame arena. Only for locals that are done
+// with by the end of the frame
+
+// std::vector equivalent
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+// std::unordered_set equivalent
+template <typename K, typename H = std::hash<K>, typename E = std::equal_to<K>>
+using FrameUnorderedSet = std::unordered_set<K, H, E, FrameAllocator<K>>;
+
+// std::unordered_map equivalent
+template <typename K, typename V, typename H = std::hash<K>, typename E = std::equal_to<K>>
+using FrameUnorderedMap = std::unordered_map<K, V, H, E, FrameAllocator<std::pair<const K, V>>>;
+
+
+
 // std::unique_ptr variant using custom memory allocator
 template <typename T>
 class UniquePtr {
@@ -2,11 +2,14 @@
 
 
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 
 #include "glm/glm.hpp"
 #include "glm/gtx/component_wise.hpp"
 
+#include "Broadphase.hpp"
 #include "Memory.hpp"
 #include "Util/Geometry.hpp"
 #include "Util/Util.hpp"
@@ -18,7 +21,7 @@ class OctreeShader;
 
 
 template <typename T>
-class Octree {
+class Octree : public Broadphase<T> {
 
     static_assert(sizeof(T) <= sizeof(intptr_t), "T must be no larger than word size");
     static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
@@ -27,40 +30,50 @@ class Octree {
 
     friend OctreeShader;
 
-    struct Node {
-
-        friend Octree;
+    static constexpr uint32_t k_none = ~uint32_t(0);
 
+    // Nodes live in one pool and refer to each other by index. A node's
+    // children are eight consecutive nodes, and its elements are a range of
+    // the shared element array
+    struct Node {
         glm::vec3 center;
         float radius;
-        Vector<T> elements;
-        UniquePtr<Node[]> children;
-        Node * parent;
+        uint32_t children; // first of the eight, or k_none if a leaf
+        uint32_t parent; // k_none for the root
+        uint32_t first; // elements are [first, first + count)
+        uint32_t count;
+        uint32_t capacity; // how many the range can hold before it has to move
         uint8_t activeOs;
         uint8_t parentO;
+    };
 
-        Node();
-        Node(const glm::vec3 & center, float radius, Node * parent, uint8_t parentO);
-        Node(const Node & other) = delete;
-        Node(Node && other) = delete;
-        
-        Node & operator=(const Node & other) = delete;
-        Node & operator=(Node && other) = delete;
-
+    // Where an element is, looked up by hashing the element
+    struct Slot {
+        T e;
+        uint32_t node;
+        uint32_t index; // into the element array, or k_none if the slot is empty
+        AABox region;
     };
 
     public:
 
-    Octree(const AABox & region, float minSize);
+    // With a looseness greater than 1, every node's bounds are grown by that
+    // factor about its center, so nodes overlap. An element then goes down to
+    // the child its center is in so long as it's small enough to fit in the
+    // child's loose bounds, rather than stopping at the first node whose
+    // center it straddles, so it ends up at a depth matching its size
+    Octree(const AABox & region, float minSize, float looseness = 1.0f);
+
+    virtual bool set(T e, const AABox & region) override;
 
-    bool set(T e, const AABox & region);
+    virtual bool remove(T e) override;
 
-    bool remove(T e);
+    virtual void clear() override;
 
-    void clear();
+    float looseness() const { return m_looseness; }
 
     // Retrieves all elements within nodes that pass the given function.
-    // F takes the center and radius of a node and returns whether it should be included.
+    // F takes the center and (loose) radius of a node and returns whether it should be included.
     size_t filter(const std::function<bool(const glm::vec3 &, float)> & f, Vector<T> & r_results) const;
     // Retrieves all elements within all nodes intersecting the given region.
     size_t filter(const AABox & region, Vector<T> & r_results) const;
@@ -69,18 +82,45 @@ class Octree {
     // Retrieves the nearest element and intersection with the given ray.
     // F takes a ray and an element and returns an Intersect.
     // FAR more efficient than the above method when only the nearest element is desired.
-    std::pair<T, Intersect> filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const;
+    virtual std::pair<T, Intersect> filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const override;
     // Retrieves all elements within all nodes intersecting the region of the given element.
-    size_t filter(T e, Vector<T> & r_results) const;
+    virtual size_t filter(T e, Vector<T> & r_results) const override;
 
     private:
 
-    bool addUp(Node & node, T e, const AABox & region);
-    void addDown(Node & node, T e, const AABox & region);
+    bool addUp(uint32_t node, uint32_t slot);
+    void addDown(uint32_t node, uint32_t slot);
+
+    // Whether the slot's element would end up right back in its node
+    bool stays(const Slot & slot) const;
 
-    void fragment(Node & node);
+    void fragment(uint32_t node);
 
-    void trim(Node & node);
+    // The child the region belongs in, or -1 if it belongs in the node itself
+    int detOctant(const Node & node, const AABox & region) const;
+
+    // Whether the region belongs in the node or below it
+    bool holds(const Node & node, const AABox & region) const;
+
+    AABox looseRegion(const Node & node) const;
+
+    void trim(uint32_t node);
+
+    // Appends the slot's element to the node's range
+    void push(uint32_t node, uint32_t slot);
+    // Takes the slot's element out of its node's range, filling the hole with
+    // the range's last element
+    void pop(uint32_t slot);
+    // Moves the node's range to the end of the element array with twice the
+    // room, first packing the array down if enough of it is unused
+    void grow(uint32_t node);
+    void compact();
+
+    uint32_t bucket(T e) const;
+    uint32_t findSlot(T e) const;
+    uint32_t insertSlot(T e);
+    void eraseSlot(uint32_t slot);
+    void rehash(int bits);
     
     size_t filter(const Node & node, const std::function<bool(const glm::vec3 &, float)> & f, Vector<T> & r_results) const;
     size_t filter(const Node & node, const AABox & region, Vector<T> & r_results) const;
@@ -90,13 +130,25 @@ class Octree {
         const glm::vec3 & invDir, const glm::vec3 & signDir, float near, float far, const uint8_t * oMap,
         T & r_elem, Intersect & r_inter
     ) const;
+    // Loose children overlap, so can't be walked in order along the ray like above
+    void filterLoose(
+        const Node & node, const Ray & ray, const std::function<Intersect(const Ray &, T)> & f,
+        const glm::vec3 & invDir, T & r_elem, Intersect & r_inter
+    ) const;
 
     private:
 
-    UniquePtr<Node> m_root;
+    Vector<Node> m_nodes; // the root is first
+    uint32_t m_freeNodes; // first of eight freed nodes, linked through their children
+    Vector<T> m_elements;
+    Vector<T> m_spare; // what the elements are packed into, kept to be reused
+    uint32_t m_waste; // element array entries no range is using
+    Vector<Slot> m_table; // open addressed, a power of 2 in size
+    int m_tableShift;
+    uint32_t m_size;
     AABox m_rootRegion;
     float m_minRadius;
-    UnorderedMap<T, std::pair<Node *, AABox>> m_map;
+    float m_looseness;
 
 };
 
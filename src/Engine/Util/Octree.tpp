@@ -85,64 +85,63 @@ inline bool contains(const AABox & b1, const AABox & b2) {
         b1.max.x >= b2.max.x;
 }
 
-}
-
-
-
-template <typename T>
-Octree<T>::Node::Node() :
-    center(),
-    radius(0.0f),
-    elements(),
-    children(),
-    parent(nullptr),
-    activeOs(0),
-    parentO(0)
-{}
+constexpr uint32_t k_octreeMinCapacity(4); // elements a node's range first has room for
+constexpr uint32_t k_octreeMinWaste(256); // unused element array entries worth packing down for
+constexpr int k_octreeTableBits(6); // the element table starts with 64 slots
 
-template <typename T>
-Octree<T>::Node::Node(const glm::vec3 & center, float radius, Node * parent, uint8_t parentO) :
-    center(center),
-    radius(radius),
-    elements(),
-    children(),
-    parent(parent),
-    activeOs(0),
-    parentO(parentO)
-{}
+}
 
 
 
 template <typename T>
-Octree<T>::Octree(const AABox & region, float minSize) {
+Octree<T>::Octree(const AABox & region, float minSize, float looseness) :
+    m_nodes(),
+    m_freeNodes(k_none),
+    m_elements(),
+    m_spare(),
+    m_waste(0),
+    m_table(),
+    m_tableShift(0),
+    m_size(0),
+    m_rootRegion(),
+    m_minRadius(0.0f),
+    m_looseness(glm::max(looseness, 1.0f))
+{
+    MemoryScope memoryScope(MemoryCategory::Octree);
     // Octree must be a cube with size a power of 2 multiple of minSize
     Util::nat iSize(Util::floor(glm::max(glm::compMax(region.max - region.min) / minSize, 1.0f)));
     iSize = Util::ceil2(iSize); // round up to nearest power of 2
     m_minRadius = minSize * 0.5f;
-    m_root = UniquePtr<Node>::make(region.center(), iSize * m_minRadius, nullptr, 0);
-    m_rootRegion.min = m_root->center - m_root->radius;
-    m_rootRegion.max = m_root->center + m_root->radius;
+    m_nodes.push_back(Node{ region.center(), iSize * m_minRadius, k_none, k_none, 0, 0, 0, 0, 0 });
+    m_rootRegion.min = m_nodes.front().center - m_nodes.front().radius;
+    m_rootRegion.max = m_nodes.front().center + m_nodes.front().radius;
+    rehash(detail::k_octreeTableBits);
 }
 
 template <typename T>
 bool Octree<T>::set(T e, const AABox & region) {
-    auto it(m_map.find(e));
-    if (it != m_map.end()) {
-        Node & node(*it->second.first);
-        m_map.erase(it);
-        for (Util::nat i(node.elements.size() - 1); i >= 0; --i) {
-            if (node.elements[i] == e) {
-                node.elements.erase(node.elements.begin() + i);
-                break;
-            }
+    MemoryScope memoryScope(MemoryCategory::Octree);
+    uint32_t slot(findSlot(e));
+    if (slot != k_none) {
+        m_table[slot].region = region;
+        // Most of the time nothing's moved far enough to change nodes
+        if (stays(m_table[slot])) {
+            return true;
+        }
+        uint32_t node(m_table[slot].node);
+        pop(slot);
+        bool res(addUp(node, slot));
+        if (!res) {
+            eraseSlot(slot);
         }
-        bool res(addUp(node, e, region));
         trim(node);
         return res;
     }
     else {
         if (detail::intersects(m_rootRegion, region)) {
-            addDown(*m_root, e, region);
+            slot = insertSlot(e);
+            m_table[slot].region = region;
+            addDown(0, slot);
             return true;
         }
         return false;
@@ -151,41 +150,47 @@ bool Octree<T>::set(T e, const AABox & region) {
 
 template <typename T>
 bool Octree<T>::remove(T e) {
-    auto it(m_map.find(e));
-    if (it == m_map.end()) {
+    MemoryScope memoryScope(MemoryCategory::Octree);
+    uint32_t slot(findSlot(e));
+    if (slot == k_none) {
         return false;
     }
 
-    Node & node(*it->second.first);
-    for (Util::nat i(node.elements.size() - 1); i >= 0; --i) {
-        if (node.elements[i] == e) {
-            node.elements.erase(node.elements.begin() + i);
-            break;
-        }
-    }
-
+    uint32_t node(m_table[slot].node);
+    pop(slot);
+    eraseSlot(slot);
     trim(node);
-
-    m_map.erase(it);
     return true;
 }
 
 template <typename T>
 void Octree<T>::clear() {
-    m_root->elements.clear();
-    m_root->children.release();
-    m_root->activeOs = 0;
-    m_map.clear();
+    MemoryScope memoryScope(MemoryCategory::Octree);
+    // everything's kept allocated, to be filled again
+    m_nodes.resize(1);
+    Node & root(m_nodes.front());
+    root.children = k_none;
+    root.first = 0;
+    root.count = 0;
+    root.capacity = 0;
+    root.activeOs = 0;
+    m_freeNodes = k_none;
+    m_elements.clear();
+    m_waste = 0;
+    for (Slot & slot : m_table) {
+        slot.index = k_none;
+    }
+    m_size = 0;
 }
 
 template <typename T>
 size_t Octree<T>::filter(const std::function<bool(const glm::vec3 &, float)> & f, Vector<T> & r_results) const {
-    return f(m_root->center, m_root->radius) ? filter(*m_root, f, r_results) : 0;
+    return f(m_nodes.front().center, m_nodes.front().radius * m_looseness) ? filter(m_nodes.front(), f, r_results) : 0;
 }
 
 template <typename T>
 size_t Octree<T>::filter(const AABox & region, Vector<T> & r_results) const {
-    return detail::intersects(m_rootRegion, region) ? filter(*m_root, region, r_results) : 0;
+    return detail::intersects(looseRegion(m_nodes.front()), region) ? filter(m_nodes.front(), region, r_results) : 0;
 }
 
 template <typename T>
@@ -196,7 +201,8 @@ size_t Octree<T>::filter(const Ray & ray, Vector<T> & r_results) const {
         Util::isZero(ray.dir.z) ? Util::infinity() : 1.0f / ray.dir.z
     );
     float near, far;
-    return detail::intersect(ray, invDir, m_rootRegion.min, m_rootRegion.max, near, far) ? filter(*m_root, ray, invDir, r_results) : 0;
+    AABox rootRegion(looseRegion(m_nodes.front()));
+    return detail::intersect(ray, invDir, rootRegion.min, rootRegion.max, near, far) ? filter(m_nodes.front(), ray, invDir, r_results) : 0;
 }
 
 template <typename T>
@@ -229,10 +235,17 @@ std::pair<T, Intersect> Octree<T>::filter(const Ray & ray, const std::function<I
     }
 
     float near, far;
-    if (!detail::intersect(ray, invDir, m_rootRegion.min, m_rootRegion.max, near, far)) {
+    AABox rootRegion(looseRegion(m_nodes.front()));
+    if (!detail::intersect(ray, invDir, rootRegion.min, rootRegion.max, near, far)) {
         return std::pair<T, Intersect>{};
     }
 
+    if (m_looseness > 1.0f) {
+        std::pair<T, Intersect> res{};
+        filterLoose(m_nodes.front(), ray, f, invDir, res.first, res.second);
+        return res;
+    }
+
     // TODO: this should be fine for you guys with your old fangled 32 bits, but should make sure
     uint64_t oMap;
     if (ray.dir.z >= 0.0f) {
@@ -287,151 +300,346 @@ std::pair<T, Intersect> Octree<T>::filter(const Ray & ray, const std::function<I
     }*/
 
     std::pair<T, Intersect> res{};
-    filter(*m_root, ray, f, invDir, signDir, near, far, reinterpret_cast<uint8_t *>(&oMap), res.first, res.second);
+    filter(m_nodes.front(), ray, f, invDir, signDir, near, far, reinterpret_cast<uint8_t *>(&oMap), res.first, res.second);
     return res;
 }
 
 template <typename T>
 size_t Octree<T>::filter(T e, Vector<T> & r_results) const {
-    auto it(m_map.find(e));
-    if (it == m_map.end()) {
+    uint32_t slot(findSlot(e));
+    if (slot == k_none) {
         return 0;
     }
 
+    // neighboring loose nodes overlap, so anything could be anywhere the
+    // region reaches
+    if (m_looseness > 1.0f) {
+        return filter(m_nodes.front(), m_table[slot].region, r_results);
+    }
+
     size_t n(0);
-    Node * node(it->second.first->parent);
-    while (node) {
-        n += node->elements.size();
-        for (T e : node->elements) {
-            r_results.push_back(e);
-        }
-        node = node->parent;
+    for (uint32_t node(m_nodes[m_table[slot].node].parent); node != k_none; node = m_nodes[node].parent) {
+        const Node & ancestor(m_nodes[node]);
+        n += ancestor.count;
+        r_results.insert(r_results.end(), m_elements.begin() + ancestor.first, m_elements.begin() + ancestor.first + ancestor.count);
     }
 
-    return n + filter(*it->second.first, it->second.second, r_results);
+    return n + filter(m_nodes[m_table[slot].node], m_table[slot].region, r_results);
 }
 
 template <typename T>
-bool Octree<T>::addUp(Node & node, T e, const AABox & region) {
-    AABox nodeRegion(node.center - node.radius, node.center + node.radius);
-    if (detail::contains(nodeRegion, region)) {
-        addDown(node, e, region);
-        return true;
-    }
-    else {
-        if (node.parent) {
-            return addUp(*node.parent, e, region);
+bool Octree<T>::addUp(uint32_t node, uint32_t slot) {
+    const AABox & region(m_table[slot].region);
+    while (true) {
+        if (holds(m_nodes[node], region)) {
+            addDown(node, slot);
+            return true;
         }
-        else {
-            if (detail::intersects(nodeRegion, region)) {
-                node.elements.push_back(e);
-                m_map[e] = std::pair<Node *, AABox>(&node, region);
-                return true;
-            }
-            return false;
+        if (m_nodes[node].parent == k_none) {
+            break;
         }
+        node = m_nodes[node].parent;
     }
+
+    if (detail::intersects(m_rootRegion, region)) {
+        push(node, slot);
+        return true;
+    }
+    return false;
 }
 
 template <typename T>
-void Octree<T>::addDown(Node & node, T e, const AABox & region) {
-    // The node is a leaf. Extra logic necessary
-    if (!node.children) {
-        // If the node is empty or at max depth, simply add to elements
-        if (!node.elements.size() || Util::isLE(node.radius, m_minRadius)) {
-            node.elements.push_back(e);
-            m_map[e] = std::pair<Node *, AABox>(&node, region);
-        }
-        else {
+void Octree<T>::addDown(uint32_t node, uint32_t slot) {
+    // nodes are refetched after every fragment, which can move the pool
+    const AABox & region(m_table[slot].region);
+    while (true) {
+        // The node is a leaf. Extra logic necessary
+        if (m_nodes[node].children == k_none) {
+            // If the node is empty or at max depth, simply add to elements
+            if (!m_nodes[node].count || Util::isLE(m_nodes[node].radius, m_minRadius)) {
+                push(node, slot);
+                return;
+            }
             // If the node only has one element, it may not have been tried
             // to be put into a sub node. Try that now
-            if (node.elements.size() == 1) {
-                T e_(node.elements.front());
-                const AABox & region_(m_map.at(e_).second);
-                int o(detail::detOctant(node.center, region_));
+            if (m_nodes[node].count == 1) {
+                uint32_t slot_(findSlot(m_elements[m_nodes[node].first]));
+                int o(detOctant(m_nodes[node], m_table[slot_].region));
                 if (o >= 0) {
                     fragment(node);
-                    addDown(node.children[o], e_, region_);
-                    node.activeOs |= 1 << o;
-                    node.elements.clear();       
+                    m_nodes[node].count = 0;
+                    m_nodes[node].activeOs |= 1 << o;
+                    addDown(m_nodes[node].children + o, slot_);
                 }
             }
-            // Try to put the new element into a sub node
-            int o(detail::detOctant(node.center, region));
-            if (o >= 0) {
-                if (!node.children) fragment(node);
-                addDown(node.children[o], e, region);
-                node.activeOs |= 1 << o;
-            }
-            else {
-                node.elements.push_back(e);
-                m_map[e] = std::pair<Node *, AABox>(&node, region);
-            }
         }
+
+        // Try to put the element into a sub node
+        int o(detOctant(m_nodes[node], region));
+        if (o < 0) {
+            push(node, slot);
+            return;
+        }
+        if (m_nodes[node].children == k_none) {
+            fragment(node);
+        }
+        m_nodes[node].activeOs |= 1 << o;
+        node = m_nodes[node].children + o;
+    }
+}
+
+template <typename T>
+bool Octree<T>::stays(const Slot & slot) const {
+    const Node & node(m_nodes[slot.node]);
+    if (!holds(node, slot.region)) {
+        // only the root keeps what it doesn't contain
+        return node.parent == k_none && detail::intersects(m_rootRegion, slot.region);
+    }
+    // a leaf it has to itself, or one at max depth, takes it right back
+    if (node.children == k_none && (node.count == 1 || Util::isLE(node.radius, m_minRadius))) {
+        return true;
+    }
+    return detOctant(node, slot.region) < 0;
+}
+
+template <typename T>
+void Octree<T>::fragment(uint32_t node) {
+    uint32_t children;
+    if (m_freeNodes != k_none) {
+        children = m_freeNodes;
+        m_freeNodes = m_nodes[children].children;
     }
-    // The typical case where the node is not a leaf
     else {
-        int o(detail::detOctant(node.center, region));
-        if (o >= 0) {
-            addDown(node.children[o], e, region);
-            node.activeOs |= 1 << o;
+        children = uint32_t(m_nodes.size());
+        m_nodes.resize(m_nodes.size() + 8);
+    }
+
+    Node & parent(m_nodes[node]);
+    parent.children = children;
+    float hr(parent.radius * 0.5f);
+    for (int o(0); o < 8; ++o) {
+        Node & child(m_nodes[children + o]);
+        child.center.x = parent.center.x + (o & 1 ? hr : -hr);
+        child.center.y = parent.center.y + (o & 2 ? hr : -hr);
+        child.center.z = parent.center.z + (o & 4 ? hr : -hr);
+        child.radius = hr;
+        child.children = k_none;
+        child.parent = node;
+        child.first = 0;
+        child.count = 0;
+        child.capacity = 0;
+        child.activeOs = 0;
+        child.parentO = uint8_t(o);
+    }
+}
+
+template <typename T>
+int Octree<T>::detOctant(const Node & node, const AABox & region) const {
+    if (m_looseness <= 1.0f) {
+        return detail::detOctant(node.center, region);
+    }
+
+    // anything whose center is within a child and is no more than this far
+    // across is within the child's loose bounds
+    float maxRadius((m_looseness - 1.0f) * node.radius * 0.5f);
+    if (glm::compMax(region.max - region.min) * 0.5f > maxRadius) {
+        return -1;
+    }
+    glm::vec3 center(region.center());
+    if (glm::compMax(glm::abs(center - node.center)) > node.radius) {
+        return -1; // only possible at the root
+    }
+    return int(center.x > node.center.x) | int(center.y > node.center.y) << 1 | int(center.z > node.center.z) << 2;
+}
+
+template <typename T>
+bool Octree<T>::holds(const Node & node, const AABox & region) const {
+    // loose nodes place by center, so the center has to be within the node
+    // proper too, which a tight node containing the region implies
+    return
+        detail::contains(looseRegion(node), region) &&
+        (m_looseness <= 1.0f || glm::compMax(glm::abs(region.center() - node.center)) <= node.radius);
+}
+
+template <typename T>
+AABox Octree<T>::looseRegion(const Node & node) const {
+    float radius(node.radius * m_looseness);
+    return AABox(node.center - radius, node.center + radius);
+}
+
+template <typename T>
+void Octree<T>::trim(uint32_t node) {
+    while (true) {
+        Node & child(m_nodes[node]);
+        if (child.count || child.children != k_none || child.parent == k_none) {
+            return;
         }
-        else {
-            node.elements.push_back(e);
-            m_map[e] = std::pair<Node *, AABox>(&node, region);
+
+        // its range sits unused until the elements are packed down
+        m_waste += child.capacity;
+        child.capacity = 0;
+
+        Node & parent(m_nodes[child.parent]);
+        parent.activeOs &= ~(1 << child.parentO);
+        if (!parent.activeOs) {
+            // back to the pool, linked through the first child
+            m_nodes[parent.children].children = m_freeNodes;
+            m_freeNodes = parent.children;
+            parent.children = k_none;
         }
+
+        node = child.parent;
     }
 }
 
 template <typename T>
-void Octree<T>::fragment(Node & node) {
-    node.children = UniquePtr<Node[]>::make(8);
-    float hr(node.radius * 0.5f);
-    glm::vec3 min(node.center - hr), max(node.center + hr);
-
-    node.children[0].center.x = min.x; node.children[0].center.y = min.y; node.children[0].center.z = min.z;
-    node.children[1].center.x = max.x; node.children[1].center.y = min.y; node.children[1].center.z = min.z;
-    node.children[2].center.x = min.x; node.children[2].center.y = max.y; node.children[2].center.z = min.z;
-    node.children[3].center.x = max.x; node.children[3].center.y = max.y; node.children[3].center.z = min.z;
-    node.children[4].center.x = min.x; node.children[4].center.y = min.y; node.children[4].center.z = max.z;
-    node.children[5].center.x = max.x; node.children[5].center.y = min.y; node.children[5].center.z = max.z;
-    node.children[6].center.x = min.x; node.children[6].center.y = max.y; node.children[6].center.z = max.z;
-    node.children[7].center.x = max.x; node.children[7].center.y = max.y; node.children[7].center.z = max.z;
-    
-    for (int o(0); o < 8; ++o) {
-        node.children[o].radius = hr;
-        node.children[o].parent = &node;
-        node.children[o].parentO = o;
+void Octree<T>::push(uint32_t node, uint32_t slot) {
+    if (m_nodes[node].count == m_nodes[node].capacity) {
+        grow(node);
+    }
+    Node & n(m_nodes[node]);
+    uint32_t index(n.first + n.count++);
+    m_elements[index] = m_table[slot].e;
+    m_table[slot].node = node;
+    m_table[slot].index = index;
+}
+
+template <typename T>
+void Octree<T>::pop(uint32_t slot) {
+    Node & node(m_nodes[m_table[slot].node]);
+    uint32_t index(m_table[slot].index), last(node.first + --node.count);
+    if (index != last) {
+        m_elements[index] = m_elements[last];
+        m_table[findSlot(m_elements[index])].index = index;
     }
 }
 
 template <typename T>
-void Octree<T>::trim(Node & node_) {
-    Node * node(&node_);
-    while (node) {
-        if (node->elements.size() || node->children || !node->parent) {
+void Octree<T>::grow(uint32_t node) {
+    if (m_waste >= detail::k_octreeMinWaste && 2 * size_t(m_waste) >= m_elements.size()) {
+        compact();
+        if (m_nodes[node].count < m_nodes[node].capacity) {
             return;
         }
+    }
 
-        node->parent->activeOs &= ~(1 << node->parentO);
-        if (!node->parent->activeOs) {
-            node->parent->children.release();
+    Node & n(m_nodes[node]);
+    uint32_t capacity(std::max(2 * n.capacity, detail::k_octreeMinCapacity));
+    uint32_t end(uint32_t(m_elements.size()));
+    // already last, so it can just be extended
+    if (n.capacity && n.first + n.capacity == end) {
+        m_elements.resize(n.first + capacity);
+    }
+    else {
+        m_elements.resize(end + capacity);
+        for (uint32_t i(0); i < n.count; ++i) {
+            m_elements[end + i] = m_elements[n.first + i];
+            m_table[findSlot(m_elements[end + i])].index = end + i;
         }
+        m_waste += n.capacity;
+        n.first = end;
+    }
+    n.capacity = capacity;
+}
 
-        node = node->parent;
+template <typename T>
+void Octree<T>::compact() {
+    // ranges are packed into the spare array, which then trades places with
+    // the element array, so neither has to be reallocated once big enough
+    m_spare.clear();
+    for (Node & node : m_nodes) {
+        uint32_t first(uint32_t(m_spare.size()));
+        node.capacity = node.count ? Util::ceil2(node.count) : 0;
+        m_spare.resize(first + node.capacity);
+        for (uint32_t i(0); i < node.count; ++i) {
+            m_spare[first + i] = m_elements[node.first + i];
+            m_table[findSlot(m_spare[first + i])].index = first + i;
+        }
+        node.first = first;
     }
+    m_elements.swap(m_spare);
+    m_waste = 0;
 }
 
 template <typename T>
-size_t Octree<T>::filter(const Node & node, const std::function<bool(const glm::vec3 &, float)> & f, Vector<T> & r_results) const {
-    size_t n(node.elements.size());
-    for (T e : node.elements) {
-        r_results.push_back(e);
+uint32_t Octree<T>::bucket(T e) const {
+    // Fibonacci hashing, so that aligned pointers still spread out
+    return uint32_t((uint64_t(std::hash<T>()(e)) * 0x9E3779B97F4A7C15ULL) >> m_tableShift);
+}
+
+template <typename T>
+uint32_t Octree<T>::findSlot(T e) const {
+    uint32_t mask(uint32_t(m_table.size()) - 1);
+    for (uint32_t i(bucket(e)); m_table[i].index != k_none; i = (i + 1) & mask) {
+        if (m_table[i].e == e) {
+            return i;
+        }
     }
-    if (node.children) {
+    return k_none;
+}
+
+template <typename T>
+uint32_t Octree<T>::insertSlot(T e) {
+    // kept no more than half full so probes stay short
+    if (2 * size_t(m_size + 1) > m_table.size()) {
+        rehash(64 - m_tableShift + 1);
+    }
+    uint32_t mask(uint32_t(m_table.size()) - 1);
+    uint32_t i(bucket(e));
+    while (m_table[i].index != k_none) {
+        i = (i + 1) & mask;
+    }
+    m_table[i].e = e;
+    m_table[i].node = k_none;
+    m_table[i].index = 0; // taken, and given its real index once added to a node
+    ++m_size;
+    return i;
+}
+
+template <typename T>
+void Octree<T>::eraseSlot(uint32_t slot) {
+    // anything after it that could sit nearer its bucket is shifted back, so
+    // there are never holes to probe past
+    uint32_t mask(uint32_t(m_table.size()) - 1);
+    uint32_t hole(slot);
+    for (uint32_t i((hole + 1) & mask); m_table[i].index != k_none; i = (i + 1) & mask) {
+        uint32_t home(bucket(m_table[i].e));
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            m_table[hole] = m_table[i];
+            hole = i;
+        }
+    }
+    m_table[hole].index = k_none;
+    --m_size;
+}
+
+template <typename T>
+void Octree<T>::rehash(int bits) {
+    Vector<Slot> old;
+    old.swap(m_table);
+    m_table.assign(size_t(1) << bits, Slot{ T(), k_none, k_none, AABox() });
+    m_tableShift = 64 - bits;
+    uint32_t mask(uint32_t(m_table.size()) - 1);
+    for (const Slot & slot : old) {
+        if (slot.index == k_none) {
+            continue;
+        }
+        uint32_t i(bucket(slot.e));
+        while (m_table[i].index != k_none) {
+            i = (i + 1) & mask;
+        }
+        m_table[i] = slot;
+    }
+}
+
+template <typename T>
+size_t Octree<T>::filter(const Node & node, const std::function<bool(const glm::vec3 &, float)> & f, Vector<T> & r_results) const {
+    size_t n(node.count);
+    r_results.insert(r_results.end(), m_elements.begin() + node.first, m_elements.begin() + node.first + node.count);
+    if (node.children != k_none) {
         for (int o(0); o < 8; ++o) {
-            if (node.activeOs & (1 << o) && f(node.children[o].center, node.children[o].radius)) {
-                n += filter(node.children[o], f, r_results);
+            if (node.activeOs & (1 << o) && f(m_nodes[node.children + o].center, m_nodes[node.children + o].radius * m_looseness)) {
+                n += filter(m_nodes[node.children + o], f, r_results);
             }
         }
     }
@@ -440,22 +648,22 @@ size_t Octree<T>::filter(const Node & node, const std::function<bool(const glm::
 
 template <typename T>
 size_t Octree<T>::filter(const Node & node, const AABox & region, Vector<T> & r_results) const {
-    size_t n(node.elements.size());    
-    for (T e : node.elements) {
-        r_results.push_back(e);
-    }
+    size_t n(node.count);
+    r_results.insert(r_results.end(), m_elements.begin() + node.first, m_elements.begin() + node.first + node.count);
 
-    if (node.children) {
+    if (node.children != k_none) {
+        // loose children reach this far past the center planes
+        float margin((m_looseness - 1.0f) * node.radius * 0.5f);
         int possible(node.activeOs);
-        if (region.max.z <= node.center.z) possible &= 0x0F;
-        if (region.min.z >= node.center.z) possible &= 0xF0;
-        if (region.max.y <= node.center.y) possible &= 0x33;
-        if (region.min.y >= node.center.y) possible &= 0xCC;
-        if (region.max.x <= node.center.x) possible &= 0x55;
-        if (region.min.x >= node.center.x) possible &= 0xAA;
+        if (region.max.z <= node.center.z - margin) possible &= 0x0F;
+        if (region.min.z >= node.center.z + margin) possible &= 0xF0;
+        if (region.max.y <= node.center.y - margin) possible &= 0x33;
+        if (region.min.y >= node.center.y + margin) possible &= 0xCC;
+        if (region.max.x <= node.center.x - margin) possible &= 0x55;
+        if (region.min.x >= node.center.x + margin) possible &= 0xAA;
         for (int o(0); o < 8; ++o) {
             if (possible & (1 << o)) {
-                n += filter(node.children[o], region, r_results);
+                n += filter(m_nodes[node.children + o], region, r_results);
             }
         }
     }
@@ -465,18 +673,16 @@ size_t Octree<T>::filter(const Node & node, const AABox & region, Vector<T> & r_
 
 template <typename T>
 size_t Octree<T>::filter(const Node & node, const Ray & ray, const glm::vec3 & invDir, Vector<T> & r_results) const {
-    size_t n(node.elements.size());    
-    for (const T & e : node.elements) {
-        r_results.push_back(e);
-    }
-    
-    if (node.children) {
+    size_t n(node.count);
+    r_results.insert(r_results.end(), m_elements.begin() + node.first, m_elements.begin() + node.first + node.count);
+
+    if (node.children != k_none) {
         for (int o(0); o < 8; ++o) {
             if (node.activeOs & (1 << o)) {
-                const Node & child(node.children[o]);
+                AABox childRegion(looseRegion(m_nodes[node.children + o]));
                 float near, far;
-                if (detail::intersect(ray, invDir, child.center - child.radius, child.center + child.radius, near, far)) {
-                    n += filter(child, ray, invDir, r_results);
+                if (detail::intersect(ray, invDir, childRegion.min, childRegion.max, near, far)) {
+                    n += filter(m_nodes[node.children + o], ray, invDir, r_results);
                 }
             }
         }
@@ -487,7 +693,8 @@ size_t Octree<T>::filter(const Node & node, const Ray & ray, const glm::vec3 & i
 
 template <typename T>
 void Octree<T>::filter(const Node & node, const Ray & ray, const std::function<Intersect(const Ray &, T)> & f, const glm::vec3 & invDir, const glm::vec3 & signDir, float near_, float far_, const uint8_t * oMap, T & r_elem, Intersect & r_inter) const {
-    for (T e : node.elements) {
+    for (uint32_t i(node.first); i < node.first + node.count; ++i) {
+        T e(m_elements[i]);
         Intersect potential(f(ray, e));
         if (potential.dist < r_inter.dist) {
             r_inter = potential;
@@ -495,7 +702,7 @@ void Octree<T>::filter(const Node & node, const Ray & ray, const std::function<I
         }
     }
     
-    if (!node.children) {
+    if (node.children == k_none) {
         return;
     }
 
@@ -521,7 +728,7 @@ void Octree<T>::filter(const Node & node, const Ray & ray, const std::function<I
         if (node.activeOs & (1 << oMap[o])) {
             Intersect potential;
             T elem;
-            filter(node.children[oMap[o]], ray, f, invDir, signDir, near, far, oMap, elem, potential);
+            filter(m_nodes[node.children + oMap[o]], ray, f, invDir, signDir, near, far, oMap, elem, potential);
             if (potential.dist < r_inter.dist) {
                 r_inter = potential;
                 r_elem = elem;
@@ -563,3 +770,36 @@ void Octree<T>::filter(const Node & node, const Ray & ray, const std::function<I
         }
     }
 }
+
+template <typename T>
+void Octree<T>::filterLoose(const Node & node, const Ray & ray, const std::function<Intersect(const Ray &, T)> & f, const glm::vec3 & invDir, T & r_elem, Intersect & r_inter) const {
+    for (uint32_t i(node.first); i < node.first + node.count; ++i) {
+        T e(m_elements[i]);
+        Intersect potential(f(ray, e));
+        if (potential.dist < r_inter.dist) {
+            r_inter = potential;
+            r_elem = e;
+        }
+    }
+
+    if (node.children == k_none) {
+        return;
+    }
+
+    // Visit children nearest first, until they start past what's been hit
+    std::pair<float, int> order[8];
+    int nOrder(0);
+    for (int o(0); o < 8; ++o) {
+        if (node.activeOs & (1 << o)) {
+            AABox childRegion(looseRegion(m_nodes[node.children + o]));
+            float near, far;
+            if (detail::intersect(ray, invDir, childRegion.min, childRegion.max, near, far)) {
+                order[nOrder++] = std::pair<float, int>(near, o);
+            }
+        }
+    }
+    std::sort(order, order + nOrder);
+    for (int i(0); i < nOrder && order[i].first < r_inter.dist; ++i) {
+        filterLoose(m_nodes[node.children + order[i].second], ray, f, invDir, r_elem, r_inter);
+    }
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+
+
+#include <algorithm>
+#include <type_traits>
+#include <cassert>
+#include <cstdint>
+
+#include "Memory.hpp"
+
+
+
+template <typename T, size_t t_chunkSize> class Pool;
+
+
+
+// Weak reference to a pooled object. Each pool slot carries a generation that
+// is bumped whenever its object is destroyed, so a handle can tell that its
+// object is gone even after the slot has been reused.
+template <typename T>
+class Handle {
+
+    template <typename U, size_t t_chunkSize> friend class Pool;
+    template <typename U> friend class Handle;
+
+    public:
+
+    Handle();
+    template <typename U, typename std::enable_if<std::is_base_of<T, U>::value, int>::type = 0>
+    Handle(const Handle<U> & other);
+
+    // Returns null if the object has been destroyed
+    T * get() const { return m_generation && *m_generation == m_expected ? m_v : nullptr; }
+
+    explicit operator bool() const { return get(); }
+
+    private:
+
+    Handle(T * v, const uint32_t * generation);
+
+    private:
+
+    T * m_v;
+    const uint32_t * m_generation;
+    uint32_t m_expected;
+
+};
+
+
+
+// Chunked object pool. Objects are stored in fixed size chunks that are never
+// moved or reallocated, so pointers and references stay valid for the life of
+// the object. Freed slots are reused before a new chunk is made, which keeps
+// live objects packed together in memory.
+// Objects that live exactly as long as a level can instead be allocated from
+// the level region, a block sized up front that is set apart from the chunks
+// and rewound all at once when the level is gone.
+template <typename T, size_t t_chunkSize = 128>
+class Pool {
+
+    struct Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type value; // must be first
+        bool live;
+        bool level; // in the level region, so only reused once it is rewound
+        uint32_t generation;
+    };
+
+    struct Chunk {
+        Slot slots[t_chunkSize];
+        size_t used;
+    };
+
+    struct LevelBlock {
+        UniquePtr<Slot[]> slots;
+        size_t capacity;
+        size_t used;
+    };
+
+    public:
+
+    Pool();
+    Pool(const Pool & other) = delete;
+    Pool(Pool && other) = delete;
+
+    ~Pool();
+
+    Pool & operator=(const Pool & other) = delete;
+    Pool & operator=(Pool && other) = delete;
+
+    // Returns uninitialized storage for a T. It is up to the caller to
+    // construct the object in place
+    void * allocate();
+
+    // Like allocate, but from the level region. The first allocation sizes
+    // the region to fit at least capacityHint objects, and it only grows if
+    // that wasn't enough
+    void * allocateLevel(size_t capacityHint);
+
+    // Rewinds the level region so its slots can be handed out again. Every
+    // object in it must already be destroyed. The memory is kept, as handles
+    // refer to it and the next level is likely to need as much
+    void releaseLevel();
+
+    // Destroys the object and returns its slot to the pool
+    void destroy(T & v);
+
+    // Gets a handle to a live object in the pool
+    Handle<T> handle(T & v) const;
+
+    // Number of live objects
+    size_t size() const { return m_size; }
+    // Number of slots across all chunks
+    size_t capacity() const { return m_chunks.size() * t_chunkSize; }
+    // Number of slots in the level region
+    size_t levelCapacity() const;
+
+    private:
+
+    Vector<UniquePtr<Chunk>> m_chunks;
+    Vector<Slot *> m_free;
+    Vector<LevelBlock> m_levelBlocks;
+    size_t m_levelBlock; // the one being filled
+    size_t m_size;
+
+};
+
+
+
+// TEMPLATE IMPLEMENTATION /////////////////////////////////////////////////////
+
+
+
+template <typename T>
+Handle<T>::Handle() :
+    m_v(nullptr),
+    m_generation(nullptr),
+    m_expected(0)
+{}
+
+template <typename T>
+template <typename U, typename std::enable_if<std::is_base_of<T, U>::value, int>::type>
+Handle<T>::Handle(const Handle<U> & other) :
+    m_v(other.m_v),
+    m_generation(other.m_generation),
+    m_expected(other.m_expected)
+{}
+
+template <typename T>
+Handle<T>::Handle(T * v, const uint32_t * generation) :
+    m_v(v),
+    m_generation(generation),
+    m_expected(*generation)
+{}
+
+
+
+template <typename T, size_t t_chunkSize>
+Pool<T, t_chunkSize>::Pool() :
+    m_chunks(),
+    m_free(),
+    m_levelBlocks(),
+    m_levelBlock(0),
+    m_size(0)
+{}
+
+template <typename T, size_t t_chunkSize>
+Pool<T, t_chunkSize>::~Pool() {
+    for (auto & chunk : m_chunks) {
+        for (size_t i(0); i < chunk->used; ++i) {
+            Slot & slot(chunk->slots[i]);
+            if (slot.live) {
+                reinterpret_cast<T &>(slot.value).~T();
+            }
+        }
+    }
+    for (LevelBlock & block : m_levelBlocks) {
+        for (size_t i(0); i < block.used; ++i) {
+            Slot & slot(block.slots[i]);
+            if (slot.live) {
+                reinterpret_cast<T &>(slot.value).~T();
+            }
+        }
+    }
+}
+
+template <typename T, size_t t_chunkSize>
+void * Pool<T, t_chunkSize>::allocate() {
+    Slot * slot;
+    if (m_free.size()) {
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        if (!m_chunks.size() || m_chunks.back()->used == t_chunkSize) {
+            m_chunks.emplace_back(UniquePtr<Chunk>::make()); // value initialized, so zeroed
+        }
+        Chunk & chunk(*m_chunks.back());
+        slot = chunk.slots + chunk.used++;
+    }
+    slot->live = true;
+    ++m_size;
+    return &slot->value;
+}
+
+template <typename T, size_t t_chunkSize>
+void * Pool<T, t_chunkSize>::allocateLevel(size_t capacityHint) {
+    while (m_levelBlock < m_levelBlocks.size() && m_levelBlocks[m_levelBlock].used == m_levelBlocks[m_levelBlock].capacity) {
+        ++m_levelBlock;
+    }
+    if (m_levelBlock == m_levelBlocks.size()) {
+        // a level that outgrew the region gets another block as big as everything before it
+        size_t capacity(std::max(std::max(capacityHint, levelCapacity()), t_chunkSize));
+        m_levelBlocks.push_back(LevelBlock{ UniquePtr<Slot[]>::make(capacity), capacity, 0 }); // value initialized, so zeroed
+    }
+    LevelBlock & block(m_levelBlocks[m_levelBlock]);
+    Slot * slot(&block.slots[block.used++]);
+    slot->live = true;
+    slot->level = true;
+    ++m_size;
+    return &slot->value;
+}
+
+template <typename T, size_t t_chunkSize>
+void Pool<T, t_chunkSize>::releaseLevel() {
+    for (LevelBlock & block : m_levelBlocks) {
+        for (size_t i(0); i < block.used; ++i) {
+            assert(!block.slots[i].live); // level objects must be destroyed first
+        }
+        block.used = 0;
+    }
+    m_levelBlock = 0;
+}
+
+template <typename T, size_t t_chunkSize>
+size_t Pool<T, t_chunkSize>::levelCapacity() const {
+    size_t capacity(0);
+    for (const LevelBlock & block : m_levelBlocks) {
+        capacity += block.capacity;
+    }
+    return capacity;
+}
+
+template <typename T, size_t t_chunkSize>
+void Pool<T, t_chunkSize>::destroy(T & v) {
+    Slot * slot(reinterpret_cast<Slot *>(&v));
+    assert(slot->live); // destroying an object that is not in the pool
+    v.~T();
+    slot->live = false;
+    ++slot->generation; // invalidates existing handles
+    if (!slot->level) {
+        m_free.push_back(slot);
+    }
+    --m_size;
+}
+
+template <typename T, size_t t_chunkSize>
+Handle<T> Pool<T, t_chunkSize>::handle(T & v) const {
+    const Slot * slot(reinterpret_cast<const Slot *>(&v));
+    assert(slot->live); // object is not in the pool
+    return Handle<T>(&v, &slot->generation);
+}
@@ -0,0 +1,129 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+
+
+namespace {
+
+// names are expected to be plain, but quotes or backslashes would break the JSON
+void writeEscaped(std::ofstream & file, const char * str) {
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') {
+            file << '\\';
+        }
+        file << *str;
+    }
+}
+
+}
+
+
+
+std::atomic<bool> Profiler::s_enabled(false);
+std::atomic<uint32_t> Profiler::s_frame(0);
+std::mutex Profiler::s_buffersMutex;
+Vector<UniquePtr<Profiler::ThreadBuffer>> Profiler::s_buffers;
+thread_local Profiler::ThreadBuffer * Profiler::t_buffer(nullptr);
+
+void Profiler::setThreadName(const String & name) {
+    threadBuffer().name = name;
+}
+
+bool Profiler::writeChromeTrace(const String & filename, int nFrames) {
+    std::ofstream file(filename.c_str());
+    if (!file) {
+        std::cerr << "Failed to write profile: " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+
+    uint32_t currentFrame(frame());
+    Vector<Vector<Event>> threadEvents(s_buffers.size());
+    int64_t start(std::numeric_limits<int64_t>::max());
+    for (int t(0); t < int(s_buffers.size()); ++t) {
+        const ThreadBuffer & buffer(*s_buffers[t]);
+        uint64_t count(buffer.count.load(std::memory_order_acquire));
+        uint64_t first(count > uint64_t(k_capacity) ? count - k_capacity : 0);
+        for (uint64_t i(first); i < count; ++i) {
+            const Event & event(buffer.events[i % k_capacity]);
+            if (currentFrame - event.frame < uint32_t(nFrames)) {
+                threadEvents[t].push_back(event);
+                start = std::min(start, event.begin);
+            }
+        }
+        // zones are recorded when they end, so parents come after children.
+        // Begin order, outermost first, is what the viewer expects
+        std::sort(threadEvents[t].begin(), threadEvents[t].end(), [](const Event & a, const Event & b) {
+            return a.begin < b.begin || (a.begin == b.begin && a.end > b.end);
+        });
+    }
+
+    file << "{\"traceEvents\":[" << std::endl;
+    file << std::fixed << std::setprecision(3);
+    bool first(true);
+    for (int t(0); t < int(s_buffers.size()); ++t) {
+        const ThreadBuffer & buffer(*s_buffers[t]);
+        if (threadEvents[t].empty()) {
+            continue;
+        }
+        file << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << buffer.id << ",\"args\":{\"name\":\"";
+        writeEscaped(file, buffer.name.c_str());
+        file << "\"}}";
+        first = false;
+        for (const Event & event : threadEvents[t]) {
+            // timestamps are in microseconds
+            file << ",\n{\"ph\":\"X\",\"name\":\"";
+            writeEscaped(file, event.name);
+            file << "\",\"pid\":0,\"tid\":" << buffer.id
+                << ",\"ts\":" << double(event.begin - start) * 1.0e-3
+                << ",\"dur\":" << double(event.end - event.begin) * 1.0e-3
+                << ",\"args\":{\"frame\":" << event.frame << "}}";
+        }
+    }
+    file << std::endl << "]}" << std::endl;
+
+    return bool(file);
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    for (UniquePtr<ThreadBuffer> & buffer : s_buffers) {
+        buffer->count.store(0, std::memory_order_release);
+    }
+}
+
+Profiler::ThreadBuffer & Profiler::threadBuffer() {
+    if (!t_buffer) {
+        UniquePtr<ThreadBuffer> buffer(UniquePtr<ThreadBuffer>::make());
+        buffer->events.resize(k_capacity);
+        buffer->count.store(0, std::memory_order_relaxed);
+
+        // the buffer stays with the profiler after the thread is gone, so
+        // its zones can still be written out
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buffer->id = int(s_buffers.size());
+        buffer->name = String("Thread ") + std::to_string(buffer->id).c_str();
+        t_buffer = buffer.get();
+        s_buffers.emplace_back(std::move(buffer));
+    }
+    return *t_buffer;
+}
+
+int64_t Profiler::now() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::record(const char * name, int64_t begin, int64_t end) {
+    ThreadBuffer & buffer(threadBuffer());
+    uint64_t count(buffer.count.load(std::memory_order_relaxed));
+    buffer.events[count % k_capacity] = Event{ name, begin, end, frame() };
+    buffer.count.store(count + 1, std::memory_order_release);
+}
@@ -0,0 +1,126 @@
+/* Profiler
+ * Times scoped zones of code on every thread and writes the last few frames
+ * out as a Chrome trace, to be opened in chrome://tracing or ui.perfetto.dev */
+#pragma once
+#ifndef _PROFILER_HPP_
+#define _PROFILER_HPP_
+
+
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "Memory.hpp"
+
+
+
+class ProfileZone;
+
+
+
+// static class
+class Profiler {
+
+    friend ProfileZone;
+
+    public:
+
+    // A zone that has ended. The name isn't copied, so must outlive the
+    // profiler, like a string literal
+    struct Event {
+        const char * name;
+        int64_t begin, end; // nanoseconds
+        uint32_t frame;
+    };
+
+    static constexpr int k_capacity = 1 << 16; // most recent events kept per thread
+
+    // Zones cost a single check while disabled
+    static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Marks the start of a new frame
+    static void beginFrame() { s_frame.fetch_add(1, std::memory_order_relaxed); }
+    static uint32_t frame() { return s_frame.load(std::memory_order_relaxed); }
+
+    // Names the calling thread in the trace
+    static void setThreadName(const String & name);
+
+    // Writes every zone of the last nFrames frames as Chrome trace event JSON.
+    // Must be called between frames, while no other thread is recording
+    static bool writeChromeTrace(const String & filename, int nFrames);
+
+    // Forgets every recorded zone. Same rules as writeChromeTrace
+    static void clear();
+
+    private:
+
+    // The zones a thread recorded, in a ring. Only the owning thread writes,
+    // and publishes each event by bumping the count, so recording never locks
+    struct ThreadBuffer {
+        int id;
+        String name;
+        Vector<Event> events;
+        std::atomic<uint64_t> count; // ever recorded
+    };
+
+    static ThreadBuffer & threadBuffer();
+
+    static int64_t now();
+
+    static void record(const char * name, int64_t begin, int64_t end);
+
+    private:
+
+    static std::atomic<bool> s_enabled;
+    static std::atomic<uint32_t> s_frame;
+    static std::mutex s_buffersMutex; // only taken the first time a thread records
+    static Vector<UniquePtr<ThreadBuffer>> s_buffers;
+    static thread_local ThreadBuffer * t_buffer; // the calling thread's, once it has recorded
+
+};
+
+
+
+// Times from construction to destruction, if the profiler was enabled when
+// constructed. Use through PROFILE_ZONE
+class ProfileZone {
+
+    public:
+
+    explicit ProfileZone(const char * name) :
+        m_name(Profiler::isEnabled() ? name : nullptr),
+        m_begin(m_name ? Profiler::now() : 0)
+    {}
+
+    ~ProfileZone() {
+        if (m_name) {
+            Profiler::record(m_name, m_begin, Profiler::now());
+        }
+    }
+
+    ProfileZone(const ProfileZone & other) = delete;
+    ProfileZone & operator=(const ProfileZone & other) = delete;
+
+    private:
+
+    const char * m_name;
+    int64_t m_begin;
+
+};
+
+
+
+// Times the rest of the enclosing scope. Compiled out with DISABLE_PROFILER
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+#ifdef DISABLE_PROFILER
+#define PROFILE_ZONE(name)
+#else
+#define PROFILE_ZONE(name) ProfileZone PROFILE_ZONE_CONCAT(profileZone_, __LINE__)(name)
+#endif
+
+
+
+#endif
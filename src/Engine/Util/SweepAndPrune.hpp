@@ -0,0 +1,90 @@
+#pragma once
+
+
+
+#include <algorithm>
+#include <cstdint>
+
+#include "glm/glm.hpp"
+#include "glm/gtx/component_wise.hpp"
+
+#include "Broadphase.hpp"
+#include "Memory.hpp"
+#include "Util/Geometry.hpp"
+#include "Util/Util.hpp"
+
+
+
+// Incremental sweep and prune. The bounds of every element are kept as sorted
+// lists of endpoints along each axis, and every pair of elements whose
+// bounds overlap is tracked. Moving an element insertion sorts its endpoints
+// back into place, and each endpoint it passes can only start or end that
+// one pair's overlap. Things move little from frame to frame, so that is
+// only a few swaps, and no queries are needed to find the overlaps.
+// Rays have nothing to go on, so are tested against every element.
+template <typename T>
+class SweepAndPrune : public Broadphase<T> {
+
+    static_assert(std::is_copy_constructible<T>::value, "T must be copy constructable");
+    static_assert(std::is_copy_assignable<T>::value, "T must be copy assignable");
+
+    struct Endpoint {
+        float value;
+        uint32_t box;
+        bool isMax;
+    };
+
+    struct Box {
+        T e;
+        AABox region;
+        uint32_t endpoints[3][2]; // index of the min and max endpoint along each axis
+        Vector<uint32_t> overlaps; // boxes whose regions overlap this one's
+    };
+
+    public:
+
+    SweepAndPrune();
+
+    virtual bool set(T e, const AABox & region) override;
+
+    virtual bool remove(T e) override;
+
+    virtual void clear() override;
+
+    virtual std::pair<T, Intersect> filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const override;
+    // Retrieves every element whose region overlaps the given element's,
+    // not including the element itself
+    virtual size_t filter(T e, Vector<T> & r_results) const override;
+
+    // Number of overlapping pairs
+    size_t nPairs() const { return m_nPairs; }
+
+    private:
+
+    // Moves the endpoint at i along the axis until it's sorted. If track,
+    // overlaps it starts or ends with the endpoints it passes are updated
+    void sort(int axis, uint32_t i, bool track);
+
+    void addPair(uint32_t b1, uint32_t b2);
+    void removePair(uint32_t b1, uint32_t b2);
+
+    // Regions that share a face count as overlapping, so nothing the octree
+    // would find is missed
+    static bool overlaps(const AABox & b1, const AABox & b2);
+
+    // Mins come before maxes of the same value, for the same reason
+    static bool less(const Endpoint & e1, const Endpoint & e2);
+
+    private:
+
+    Vector<Endpoint> m_endpoints[3];
+    Vector<Box> m_boxes;
+    Vector<uint32_t> m_freeBoxes;
+    UnorderedMap<T, uint32_t> m_indices;
+    size_t m_nPairs;
+
+};
+
+
+
+#include "SweepAndPrune.tpp"
@@ -0,0 +1,229 @@
+template <typename T>
+SweepAndPrune<T>::SweepAndPrune() :
+    m_endpoints(),
+    m_boxes(),
+    m_freeBoxes(),
+    m_indices(),
+    m_nPairs(0)
+{}
+
+template <typename T>
+bool SweepAndPrune<T>::set(T e, const AABox & region) {
+    MemoryScope memoryScope(MemoryCategory::Collision);
+    auto it(m_indices.find(e));
+    if (it == m_indices.end()) {
+        uint32_t b;
+        if (m_freeBoxes.size()) {
+            b = m_freeBoxes.back();
+            m_freeBoxes.pop_back();
+        }
+        else {
+            b = uint32_t(m_boxes.size());
+            m_boxes.emplace_back();
+        }
+        Box & box(m_boxes[b]);
+        box.e = e;
+        box.region = region;
+        m_indices[e] = b;
+
+        // added at the ends and sorted down, picking up overlaps on the way
+        for (int axis(0); axis < 3; ++axis) {
+            Vector<Endpoint> & endpoints(m_endpoints[axis]);
+            box.endpoints[axis][0] = uint32_t(endpoints.size());
+            endpoints.push_back(Endpoint{ region.min[axis], b, false });
+            box.endpoints[axis][1] = uint32_t(endpoints.size());
+            endpoints.push_back(Endpoint{ region.max[axis], b, true });
+            sort(axis, box.endpoints[axis][0], true);
+            sort(axis, box.endpoints[axis][1], true);
+        }
+        return true;
+    }
+
+    uint32_t b(it->second);
+    Box & box(m_boxes[b]);
+    AABox prevRegion(box.region);
+    box.region = region;
+    for (int axis(0); axis < 3; ++axis) {
+        Vector<Endpoint> & endpoints(m_endpoints[axis]);
+        endpoints[box.endpoints[axis][0]].value = region.min[axis];
+        endpoints[box.endpoints[axis][1]].value = region.max[axis];
+        // the endpoint leading the way goes first, so the two never cross
+        if (region.min[axis] < prevRegion.min[axis]) {
+            sort(axis, box.endpoints[axis][0], true);
+            sort(axis, box.endpoints[axis][1], true);
+        }
+        else {
+            sort(axis, box.endpoints[axis][1], true);
+            sort(axis, box.endpoints[axis][0], true);
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool SweepAndPrune<T>::remove(T e) {
+    MemoryScope memoryScope(MemoryCategory::Collision);
+    auto it(m_indices.find(e));
+    if (it == m_indices.end()) {
+        return false;
+    }
+
+    uint32_t b(it->second);
+    Box & box(m_boxes[b]);
+    for (uint32_t other : box.overlaps) {
+        Vector<uint32_t> & otherOverlaps(m_boxes[other].overlaps);
+        otherOverlaps.erase(std::find(otherOverlaps.begin(), otherOverlaps.end(), b));
+    }
+    m_nPairs -= box.overlaps.size();
+    box.overlaps.clear();
+
+    for (int axis(0); axis < 3; ++axis) {
+        Vector<Endpoint> & endpoints(m_endpoints[axis]);
+        uint32_t minI(box.endpoints[axis][0]), maxI(box.endpoints[axis][1]);
+        endpoints.erase(endpoints.begin() + maxI);
+        endpoints.erase(endpoints.begin() + minI);
+        for (uint32_t i(minI); i < endpoints.size(); ++i) {
+            m_boxes[endpoints[i].box].endpoints[axis][endpoints[i].isMax] = i;
+        }
+    }
+
+    m_freeBoxes.push_back(b);
+    m_indices.erase(it);
+    return true;
+}
+
+template <typename T>
+void SweepAndPrune<T>::clear() {
+    MemoryScope memoryScope(MemoryCategory::Collision);
+    for (int axis(0); axis < 3; ++axis) {
+        m_endpoints[axis].clear();
+    }
+    m_boxes.clear();
+    m_freeBoxes.clear();
+    m_indices.clear();
+    m_nPairs = 0;
+}
+
+template <typename T>
+std::pair<T, Intersect> SweepAndPrune<T>::filter(const Ray & ray, const std::function<Intersect(const Ray &, T)> & f) const {
+    glm::vec3 invDir(
+        Util::isZero(ray.dir.x) ? Util::infinity() : 1.0f / ray.dir.x,
+        Util::isZero(ray.dir.y) ? Util::infinity() : 1.0f / ray.dir.y,
+        Util::isZero(ray.dir.z) ? Util::infinity() : 1.0f / ray.dir.z
+    );
+    std::pair<T, Intersect> res{};
+    for (const auto & pair : m_indices) {
+        const AABox & region(m_boxes[pair.second].region);
+        glm::vec3 tsLow((region.min - ray.pos) * invDir);
+        glm::vec3 tsHigh((region.max - ray.pos) * invDir);
+        float tMin(glm::compMax(glm::min(tsLow, tsHigh)));
+        float tMax(glm::compMin(glm::max(tsLow, tsHigh)));
+        // extra negation so that a NaN case is skipped, and no need to try
+        // anything farther than what's been hit
+        if (!(tMax > 0.0f && tMax >= tMin) || tMin >= res.second.dist) {
+            continue;
+        }
+        Intersect potential(f(ray, pair.first));
+        if (potential.dist < res.second.dist) {
+            res.first = pair.first;
+            res.second = potential;
+        }
+    }
+    return res;
+}
+
+template <typename T>
+size_t SweepAndPrune<T>::filter(T e, Vector<T> & r_results) const {
+    auto it(m_indices.find(e));
+    if (it == m_indices.end()) {
+        return 0;
+    }
+
+    const Vector<uint32_t> & overlaps(m_boxes[it->second].overlaps);
+    for (uint32_t other : overlaps) {
+        r_results.push_back(m_boxes[other].e);
+    }
+    return overlaps.size();
+}
+
+template <typename T>
+void SweepAndPrune<T>::sort(int axis, uint32_t i, bool track) {
+    Vector<Endpoint> & endpoints(m_endpoints[axis]);
+    Endpoint endpoint(endpoints[i]);
+
+    // moving down, a min passing a max starts an overlap along this axis, and
+    // a max passing a min ends one
+    while (i > 0 && less(endpoint, endpoints[i - 1])) {
+        const Endpoint & other(endpoints[i - 1]);
+        if (track && other.box != endpoint.box && endpoint.isMax != other.isMax) {
+            if (other.isMax) {
+                if (overlaps(m_boxes[endpoint.box].region, m_boxes[other.box].region)) addPair(endpoint.box, other.box);
+            }
+            else {
+                removePair(endpoint.box, other.box);
+            }
+        }
+        endpoints[i] = other;
+        m_boxes[other.box].endpoints[axis][other.isMax] = i;
+        --i;
+    }
+    // and the other way round moving up
+    while (i + 1 < endpoints.size() && less(endpoints[i + 1], endpoint)) {
+        const Endpoint & other(endpoints[i + 1]);
+        if (track && other.box != endpoint.box && endpoint.isMax != other.isMax) {
+            if (endpoint.isMax) {
+                if (overlaps(m_boxes[endpoint.box].region, m_boxes[other.box].region)) addPair(endpoint.box, other.box);
+            }
+            else {
+                removePair(endpoint.box, other.box);
+            }
+        }
+        endpoints[i] = other;
+        m_boxes[other.box].endpoints[axis][other.isMax] = i;
+        ++i;
+    }
+
+    endpoints[i] = endpoint;
+    m_boxes[endpoint.box].endpoints[axis][endpoint.isMax] = i;
+}
+
+template <typename T>
+void SweepAndPrune<T>::addPair(uint32_t b1, uint32_t b2) {
+    Vector<uint32_t> & overlaps1(m_boxes[b1].overlaps);
+    // may already overlap if the pair started overlapping along another axis
+    // earlier in the same move
+    if (std::find(overlaps1.begin(), overlaps1.end(), b2) != overlaps1.end()) {
+        return;
+    }
+    overlaps1.push_back(b2);
+    m_boxes[b2].overlaps.push_back(b1);
+    ++m_nPairs;
+}
+
+template <typename T>
+void SweepAndPrune<T>::removePair(uint32_t b1, uint32_t b2) {
+    Vector<uint32_t> & overlaps1(m_boxes[b1].overlaps);
+    auto it(std::find(overlaps1.begin(), overlaps1.end(), b2));
+    if (it == overlaps1.end()) {
+        return;
+    }
+    *it = overlaps1.back();
+    overlaps1.pop_back();
+    Vector<uint32_t> & overlaps2(m_boxes[b2].overlaps);
+    *std::find(overlaps2.begin(), overlaps2.end(), b1) = overlaps2.back();
+    overlaps2.pop_back();
+    --m_nPairs;
+}
+
+template <typename T>
+bool SweepAndPrune<T>::overlaps(const AABox & b1, const AABox & b2) {
+    return
+        b1.min.x <= b2.max.x && b2.min.x <= b1.max.x &&
+        b1.min.y <= b2.max.y && b2.min.y <= b1.max.y &&
+        b1.min.z <= b2.max.z && b2.min.z <= b1.max.z;
+}
+
+template <typename T>
+bool SweepAndPrune<T>::less(const Endpoint & e1, const Endpoint & e2) {
+    return e1.value < e2.value || (e1.value == e2.value && !e1.isMax && e2.isMax);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+
+
+#include <atomic>
+
+
+
+// Dense, zero based integer IDs for types within a family, such as components
+// or messages. A type's ID is fixed the first time it is asked for, and from
+// then on is a single static load, so IDs can index flat arrays in place of
+// hashing std::type_index.
+template <typename FamilyT>
+class TypeIDs {
+
+    public:
+
+    template <typename T> static int get();
+
+    // Number of IDs handed out so far
+    static int count() { return s_count; }
+
+    private:
+
+    static std::atomic<int> s_count;
+
+};
+
+
+
+// TEMPLATE IMPLEMENTATION /////////////////////////////////////////////////////
+
+
+
+template <typename FamilyT>
+std::atomic<int> TypeIDs<FamilyT>::s_count(0);
+
+template <typename FamilyT>
+template <typename T>
+int TypeIDs<FamilyT>::get() {
+    static const int s_id(s_count++);
+    return s_id;
+}
@@ -221,7 +221,7 @@ struct Util {
             return false;
         }
         
-        std::basic_stringstream<char, std::char_traits<char>, ScopedAllocator<char>> ss;
+        std::basic_stringstream<char, std::char_traits<char>, String::allocator_type> ss;
         ss << ifs.rdbuf();
         ifs.close();
         dst = ss.str();